@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/rag_input.h"
+#include "../GRAPH CORE/reach_query.h"
+
+// Reads the TRJ_AL input, then candidate edges "source destination" until EOF.
+// Adding source -> destination closes a cycle exactly when destination
+// already reaches source. Queries are checked against the loaded graph.
+// Usage: BIQ_AL [budget]   (edges scanned per query, 0 or omitted means no limit)
+int main(int argc, char* argv[]) {
+    long long budget = (argc > 1) ? atoll(argv[1]) : 0;
+    char source[MAX_NAME_LENGTH], destination[MAX_NAME_LENGTH];
+
+    // Node names interned to dense indexes
+    InternTable nodeNames;
+    CsrGraph graph;
+    if (ragRead(&nodeNames, &graph, NULL) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    ReachQuery query;
+    if (reachQueryInit(&query, &graph) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    // Queries: source destination of the candidate edge
+    printf("Enter candidate edges (source destination):\n");
+    int safe = 0, unsafe = 0, undecided = 0;
+    long long scanned = 0;
+    while (scanf("%63s %63s", source, destination) == 2) {
+        int u = internLookup(&nodeNames, source);
+        int v = internLookup(&nodeNames, destination);
+        if (u == -1 || v == -1) {
+            printf("Invalid query: %s -> %s\n", source, destination);
+            continue;
+        }
+
+        int result = reachQueryRun(&query, v, u, budget);
+        scanned += query.edgesScanned;
+        if (result == 1) {
+            printf("Edge %s -> %s would close a cycle (deadlock)\n", source, destination);
+            unsafe++;
+        } else if (result == 0) {
+            printf("Edge %s -> %s is safe\n", source, destination);
+            safe++;
+        } else {
+            printf("Edge %s -> %s is undecided after %lld edge(s); treat it as unsafe\n", source, destination, budget);
+            undecided++;
+        }
+    }
+
+    int queries = safe + unsafe + undecided;
+    printf("\n%d query(ies): %d safe, %d would deadlock, %d over budget.\n", queries, safe, unsafe, undecided);
+    if (queries > 0) {
+        printf("%.1f edge(s) scanned per query on a graph of %d edge(s).\n", (double)scanned / queries, graph.numEdges);
+    }
+
+    // Free dynamically allocated memory
+    internFree(&nodeNames);
+    csrFree(&graph);
+    reachQueryFree(&query);
+
+    return 0;
+}
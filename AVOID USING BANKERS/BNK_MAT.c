@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GRAPH CORE/bankers.h"
+#include "../GRAPH CORE/intern_table.h"
+
+// Function to read rows x numResources non-negative counts into a padded matrix.
+// Returns 0 on success, -1 on a missing or negative entry.
+int readMatrix(int* matrix, int rows, int numResources, int stride) {
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < numResources; j++) {
+            int* entry = &matrix[(size_t)i * stride + j];
+            if (scanf("%d", entry) != 1 || *entry < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+// Function to print the verdict on one request
+void printDecision(const InternTable* processNames, int p, const int* request, int numResources, int granted) {
+    printf("%s %s (", internName(processNames, p), granted ? "granted" : "must wait for");
+    for (int j = 0; j < numResources; j++) {
+        printf(j ? " %d" : "%d", request[j]);
+    }
+    printf(")\n");
+}
+
+// Function to read requests until EOF and decide them batchSize at a time
+void serveRequests(BankerState* state, const InternTable* processNames, int batchSize) {
+    int numResources = state->numResources, stride = state->stride;
+    char name[MAX_NAME_LENGTH];
+    int* requests = matrixCreate(batchSize, stride);
+    int* processes = (int*)malloc((batchSize + 1) * sizeof(int));
+    unsigned char* granted = (unsigned char*)malloc(batchSize + 1);
+    if (!requests || !processes || !granted) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    // Requests are queued until a batch is full or the input ends
+    printf("Enter requests (process units...):\n");
+    int numGranted = 0, numWaiting = 0, pendingCount = 0, done = 0;
+    while (!done) {
+        int p = -1;
+        int* request = requests + (size_t)pendingCount * stride;
+        if (scanf("%63s", name) != 1 || readMatrix(request, 1, numResources, stride) != 0) {
+            done = 1;
+        } else if ((p = internLookup(processNames, name)) == -1) {
+            printf("Invalid process name: %s\n", name);
+        } else if (!bankerFits(request, state->need + (size_t)p * stride, stride)) {
+            printf("Invalid request from %s: exceeds its claim\n", name);
+        } else {
+            processes[pendingCount++] = p;
+        }
+        if (pendingCount == 0 || (pendingCount < batchSize && !done)) {
+            continue;
+        }
+
+        // One request goes through the exact check, a batch through one walk
+        int result = (pendingCount == 1) ? bankerRequest(state, processes[0], requests)
+                                         : bankerRequestBatch(state, pendingCount, processes, requests, granted);
+        if (result < 0) {
+            printf("Memory allocation failed\n");
+            exit(1);
+        }
+        if (pendingCount == 1) {
+            granted[0] = (unsigned char)result;
+        }
+        for (int b = 0; b < pendingCount; b++) {
+            printDecision(processNames, processes[b], requests + (size_t)b * stride, numResources, granted[b]);
+            if (granted[b]) {
+                numGranted++;
+            } else {
+                numWaiting++;
+            }
+        }
+        pendingCount = 0;
+    }
+
+    printf("\n%d request(s) granted, %d must wait.\n", numGranted, numWaiting);
+    printf("%lld check(s) on the cached sequence, %lld full safety check(s).\n", state->prefixChecks, state->fullChecks);
+
+    free(requests);
+    free(processes);
+    free(granted);
+}
+
+// Reads the Available vector and the Allocation and Maximum matrices, then
+// requests "process u1 .. um" until EOF, granting only those that keep the
+// state safe.
+// Usage: BNK_MAT [batchSize]   (requests decided together, 1 by default)
+int main(int argc, char* argv[]) {
+    int numProcesses, numResources;
+    int batchSize = (argc > 1) ? atoi(argv[1]) : 1;
+    char name[MAX_NAME_LENGTH];
+    if (batchSize < 1) {
+        batchSize = 1;
+    }
+
+    printf("Enter number of processes and resource types: ");
+    if (scanf("%d %d", &numProcesses, &numResources) != 2 || numProcesses < 0 || numResources < 0) {
+        printf("Invalid input\n");
+        exit(1);
+    }
+
+    InternTable processNames, resourceNames;
+    if (internInit(&processNames, numProcesses) != 0 || internInit(&resourceNames, numResources) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    printf("Enter process names: ");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        if (internLookup(&processNames, name) != -1 || internAdd(&processNames, name) == -1) {
+            printf("Invalid process name: %s\n", name);
+            exit(1);
+        }
+    }
+
+    printf("Enter resource names: ");
+    for (int j = 0; j < numResources; j++) {
+        scanf("%63s", name);
+        if (internLookup(&resourceNames, name) != -1 || internAdd(&resourceNames, name) == -1) {
+            printf("Invalid resource name: %s\n", name);
+            exit(1);
+        }
+    }
+
+    int stride = matrixStride(numResources);
+    int* available = matrixCreate(1, stride);
+    int* allocation = matrixCreate(numProcesses, stride);
+    int* maximum = matrixCreate(numProcesses, stride);
+    if (!available || !allocation || !maximum) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    printf("Enter available units per resource:\n");
+    if (readMatrix(available, 1, numResources, stride) != 0) {
+        printf("Invalid available vector\n");
+        exit(1);
+    }
+    printf("Enter allocation matrix:\n");
+    if (readMatrix(allocation, numProcesses, numResources, stride) != 0) {
+        printf("Invalid allocation matrix\n");
+        exit(1);
+    }
+    printf("Enter maximum matrix:\n");
+    if (readMatrix(maximum, numProcesses, numResources, stride) != 0) {
+        printf("Invalid maximum matrix\n");
+        exit(1);
+    }
+
+    BankerState state;
+    int safe = bankerInit(&state, available, maximum, allocation, numProcesses, numResources);
+    if (safe < 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+    if (safe == 0) {
+        printf("\nThe initial state is not safe\n");
+    } else {
+        printf("\nSafe sequence: ");
+        for (int t = 0; t < numProcesses; t++) {
+            printf("%s ", internName(&processNames, state.sequence[t]));
+        }
+        printf("\n");
+        serveRequests(&state, &processNames, batchSize);
+    }
+
+    // Free dynamically allocated memory
+    bankerFree(&state);
+    internFree(&processNames);
+    internFree(&resourceNames);
+    free(available);
+    free(allocation);
+    free(maximum);
+
+    return 0;
+}
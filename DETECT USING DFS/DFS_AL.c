@@ -1,127 +1,119 @@
 #include <stdio.h>
 #include <stdlib.h>
-
-#define MAX_VERTICES 52  // Maximum vertices (26 lowercase + 26 uppercase)
-
-// Node structure for the adjacency list
-typedef struct Node {
-    int vertex;
-    struct Node* next;
-} Node;
-
-// Function to create a new node
-Node* createNode(int vertex) {
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    newNode->vertex = vertex;
-    newNode->next = NULL;
-    return newNode;
-}
-
-// Function to add an edge to the adjacency list
-void addEdge(Node** adjList, int src, int dest) {
-    Node* newNode = createNode(dest);
-    newNode->next = adjList[src];
-    adjList[src] = newNode;
-}
-
-// Function to find the index of a vertex in labels array
-int findIndex(char* labels, int size, char vertex) {
-    for (int i = 0; i < size; i++) {
-        if (labels[i] == vertex) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-// Cycle detection and printing function
-int detectCycle(Node** adjList, int vertex, int* visited, int* recStack, char* labels, int* path, int pathIdx) {
-    visited[vertex] = 1;
-    recStack[vertex] = 1;
-    path[pathIdx++] = vertex;
-
-    Node* temp = adjList[vertex];
-    while (temp) {
-        int adjVertex = temp->vertex;
-
-        if (!visited[adjVertex]) {  // If adjVertex is not visited
-            if (detectCycle(adjList, adjVertex, visited, recStack, labels, path, pathIdx)) {
-                return 1;
-            }
-        } else if (recStack[adjVertex]) {  // Cycle detected
-            printf("Cycle detected: ");
-            for (int i = 0; i < pathIdx; i++) {
-                if (path[i] == adjVertex) {  // Start of the cycle
-                    for (int j = i; j < pathIdx; j++) {
-                        printf("%c -> ", labels[path[j]]);
-                    }
-                    printf("%c\n", labels[adjVertex]);
-                    return 1;
-                }
-            }
-        }
-
-        temp = temp->next;
-    }
-
-    recStack[vertex] = 0;
-    return 0;
-}
-
-int main() {
+#include <string.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/cycle_report.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/trim.h"
+#include "../GRAPH CORE/wait_for.h"
+
+// Usage: DFS_AL [--wait-for]
+// --wait-for searches the wait-for projection, with single-instance
+// resources folded into process -> process edges.
+int main(int argc, char* argv[]) {
     int numProcesses, numResources, edges;
+    int waitFor = (argc > 1 && strcmp(argv[1], "--wait-for") == 0);
 
     printf("Enter the number of processes, resources, and edges:\n");
     scanf("%d %d %d", &numProcesses, &numResources, &edges);
 
     int totalVertices = numProcesses + numResources;
-    char labels[MAX_VERTICES];
 
-    // Input process and resource labels
-    printf("Enter process labels (lowercase a-z):\n");
+    // Input process and resource labels, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
     for (int i = 0; i < numProcesses; i++) {
-        scanf(" %c", &labels[i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
-    printf("Enter resource labels (uppercase A-Z):\n");
+    int processCount = labels.count;
+    printf("Enter resource labels:\n");
     for (int i = 0; i < numResources; i++) {
-        scanf(" %c", &labels[numProcesses + i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
+    totalVertices = labels.count;  // Repeated labels share one vertex
 
-    // Initialize adjacency list
-    Node** adjList = (Node**)malloc(totalVertices * sizeof(Node*));
-    for (int i = 0; i < totalVertices; i++) {
-        adjList[i] = NULL;
-    }
+    // Edge stream, compressed into CSR once all edges are read
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int edgeCount = 0;
 
     // Input edges
     for (int i = 0; i < edges; i++) {
-        char src, dest;
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
         printf("Enter edge (source and destination): ");
-        scanf(" %c %c", &src, &dest);
+        scanf("%63s %63s", src, dest);
 
-        int srcIndex = findIndex(labels, totalVertices, src);
-        int destIndex = findIndex(labels, totalVertices, dest);
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
 
         if (srcIndex != -1 && destIndex != -1) {
-            addEdge(adjList, srcIndex, destIndex);
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            edgeCount++;
         }
     }
 
-    // Arrays for visited, recursion stack, and path tracking
-    int* visited = (int*)malloc(totalVertices * sizeof(int));
-    int* recStack = (int*)malloc(totalVertices * sizeof(int));
-    int* path = (int*)malloc(totalVertices * sizeof(int));
+    CsrGraph graph;
+    if (csrBuild(&graph, totalVertices, edgeCount, srcList, destList, NULL) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    free(srcList);
+    free(destList);
+
+    // Optionally search the wait-for projection instead of the full graph
+    WaitForGraph wfg;
+    const WaitForGraph* projection = NULL;
+    const CsrGraph* search = &graph;
+    if (waitFor) {
+        if (waitForProject(&graph, processCount, &wfg) != 0) {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+        printf("\nWait-for graph: %d of %d vertices kept, %d resource(s) folded into edges.\n",
+               wfg.graph.numVertices, totalVertices, wfg.collapsed);
+        projection = &wfg;
+        search = &wfg.graph;
+        totalVertices = wfg.graph.numVertices;
+    }
+
+    // Vertex states, explicit DFS frame stack, and cycle buffers, all bounded by V
+    unsigned char* state = (unsigned char*)calloc(totalVertices, sizeof(unsigned char));
+    DfsFrame* frames = (DfsFrame*)malloc(totalVertices * sizeof(DfsFrame));
+    int* cycle = (int*)malloc(totalVertices * sizeof(int));
+    int* expanded = (int*)malloc((2 * totalVertices + 1) * sizeof(int));
+    unsigned char* alive = (unsigned char*)malloc(totalVertices + 1);
+    if (!state || !frames || !cycle || !expanded || !alive) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
 
+    // Peel sources and sinks first; pruned vertices count as fully explored
+    int pruned = csrTrim(search, alive);
+    if (pruned < 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    printf("\nTrimmed %d of %d vertices before cycle search.\n", pruned, totalVertices);
     for (int i = 0; i < totalVertices; i++) {
-        visited[i] = 0;
-        recStack[i] = 0;
+        if (!alive[i]) {
+            state[i] = DFS_DONE;
+        }
     }
 
     // Check each vertex for cycle detection
     int cycleDetected = 0;
     for (int i = 0; i < totalVertices; i++) {
-        if (!visited[i]) {
-            if (detectCycle(adjList, i, visited, recStack, labels, path, 0)) {
+        if (state[i] == DFS_UNVISITED) {
+            if (cycleReportFrom(search, i, state, &labels, frames, cycle, projection, expanded)) {
                 cycleDetected = 1;
                 break;
             }
@@ -135,18 +127,16 @@ int main() {
     }
 
     // Free allocated memory
-    for (int i = 0; i < totalVertices; i++) {
-        Node* temp;
-        while (adjList[i]) {
-            temp = adjList[i];
-            adjList[i] = adjList[i]->next;
-            free(temp);
-        }
+    csrFree(&graph);
+    if (waitFor) {
+        waitForFree(&wfg);
     }
-    free(adjList);
-    free(visited);
-    free(recStack);
-    free(path);
+    internFree(&labels);
+    free(state);
+    free(frames);
+    free(cycle);
+    free(expanded);
+    free(alive);
 
     return 0;
 }
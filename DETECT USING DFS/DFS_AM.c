@@ -1,55 +1,56 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#define MAX_VERTICES 52  // Maximum vertices (26 lowercase + 26 uppercase)
-
-// Function to find the index of a vertex in labels array
-int findIndex(char* labels, int size, char vertex) {
-    for (int i = 0; i < size; i++) {
-        if (labels[i] == vertex) {
-            return i;
+#include "../GRAPH CORE/bit_matrix.h"
+#include "../GRAPH CORE/dfs_cycle.h"
+#include "../GRAPH CORE/intern_table.h"
+
+// Cycle detection function, iterative: each frame keeps the next column to scan,
+// so memory is bounded by the number of vertices rather than the native stack.
+// Neighbors are found a word at a time and visited/onStack are bitsets.
+int detectCycle(const BitMatrix* adjMatrix, int root, uint64_t* visited, uint64_t* onStack, const InternTable* labels, DfsFrame* frames) {
+    int top = 0;
+    frames[0].vertex = root;
+    frames[0].cursor = 0;
+    bitsetSet(visited, root);
+    bitsetSet(onStack, root);
+
+    while (top >= 0) {
+        DfsFrame* frame = &frames[top];
+        int vertex = frame->vertex;
+
+        // Advance to the next column with an edge
+        int adjVertex = bmNextInRow(adjMatrix, vertex, frame->cursor);
+        if (adjVertex == -1) {
+            bitsetClear(onStack, vertex);  // Remove the vertex from the recursion stack
+            top--;
+            continue;
         }
-    }
-    return -1;
-}
+        frame->cursor = adjVertex + 1;
+
+        if (!bitsetTest(visited, adjVertex)) {  // If adjVertex is not visited
+            bitsetSet(visited, adjVertex);
+            bitsetSet(onStack, adjVertex);
+            top++;
+            frames[top].vertex = adjVertex;
+            frames[top].cursor = 0;
+        } else if (bitsetTest(onStack, adjVertex)) {  // Cycle detected
+            // We found a cycle, print it starting from adjVertex's frame
+            int cycleStartIndex = top;
+            while (frames[cycleStartIndex].vertex != adjVertex) {
+                cycleStartIndex--;
+            }
 
-// Cycle detection function
-int detectCycle(int** adjMatrix, int vertex, int* visited, int* recStack, char* labels, int* path, int pathIdx, int totalVertices) {
-    visited[vertex] = 1;       // Mark the vertex as visited
-    recStack[vertex] = 1;      // Add the vertex to the recursion stack
-    path[pathIdx++] = vertex;  // Add the vertex to the path
-
-    for (int adjVertex = 0; adjVertex < totalVertices; adjVertex++) {
-        if (adjMatrix[vertex][adjVertex]) {  // Check if there is an edge
-            if (!visited[adjVertex]) {  // If adjVertex is not visited
-                if (detectCycle(adjMatrix, adjVertex, visited, recStack, labels, path, pathIdx, totalVertices)) {
-                    return 1;  // Cycle detected
-                }
-            } else if (recStack[adjVertex]) {  // Cycle detected
-                // We found a cycle, print it
-                printf("Cycle detected: ");
-                int cycleStartIndex = -1;
-
-                // Find the starting point of the cycle in the path
-                for (int i = 0; i < pathIdx; i++) {
-                    if (path[i] == adjVertex) {
-                        cycleStartIndex = i;  // Start from the first occurrence of adjVertex
-                        break;
-                    }
-                }
-                
-                // Print the cycle path
-                for (int j = cycleStartIndex; j < pathIdx; j++) {
-                    printf("%c -> ", labels[path[j]]);
-                }
-                printf("%c\n", labels[adjVertex]); // Complete the cycle output
-                return 1;  // Cycle detected
+            printf("Cycle detected: ");
+            for (int j = cycleStartIndex; j <= top; j++) {
+                printf("%s -> ", internName(labels, frames[j].vertex));
             }
+            printf("%s\n", internName(labels, adjVertex)); // Complete the cycle output
+            return 1;  // Cycle detected
         }
     }
 
-    recStack[vertex] = 0;  // Remove the vertex from the recursion stack
-    return 0;              // No cycle detected
+    return 0;  // No cycle detected
 }
 
 int main() {
@@ -62,48 +63,57 @@ int main() {
     }
 
     int totalVertices = numProcesses + numResources;
-    char* labels = (char*)malloc(MAX_VERTICES * sizeof(char));  // Dynamic allocation for labels array
 
-    // Input process and resource labels
-    printf("Enter process labels (lowercase a-z):\n");
+    // Input process and resource labels, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
     for (int i = 0; i < numProcesses; i++) {
-        scanf(" %c", &labels[i]);  // Space before %c to clear buffer
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
-    printf("Enter resource labels (uppercase A-Z):\n");
+    printf("Enter resource labels:\n");
     for (int i = 0; i < numResources; i++) {
-        scanf(" %c", &labels[numProcesses + i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
+    totalVertices = labels.count;  // Repeated labels share one vertex
 
-    // Initialize adjacency matrix
-    int** adjMatrix = (int**)malloc(totalVertices * sizeof(int*));
-    for (int i = 0; i < totalVertices; i++) {
-        adjMatrix[i] = (int*)calloc(totalVertices, sizeof(int));
+    // Initialize bit-packed adjacency matrix
+    BitMatrix adjMatrix;
+    if (bmCreate(&adjMatrix, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
     }
 
     // Input edges
     for (int i = 0; i < edges; i++) {
-        char src, dest;
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
         printf("Enter edge (source and destination): ");
-        scanf(" %c %c", &src, &dest);
+        scanf("%63s %63s", src, dest);
 
-        int srcIndex = findIndex(labels, totalVertices, src);
-        int destIndex = findIndex(labels, totalVertices, dest);
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
 
         if (srcIndex != -1 && destIndex != -1) {
-            adjMatrix[srcIndex][destIndex] = 1;  // Add directed edge
+            bmSet(&adjMatrix, srcIndex, destIndex);  // Add directed edge
         }
     }
 
-    // Arrays for visited, recursion stack, and path tracking
-    int* visited = (int*)calloc(totalVertices, sizeof(int));
-    int* recStack = (int*)calloc(totalVertices, sizeof(int));
-    int* path = (int*)malloc(totalVertices * sizeof(int));
+    // Visited and recursion-stack bitsets, and the explicit DFS frame stack
+    uint64_t* visited = bitsetCreate(totalVertices);
+    uint64_t* onStack = bitsetCreate(totalVertices);
+    DfsFrame* frames = (DfsFrame*)malloc(totalVertices * sizeof(DfsFrame));
 
     // Check each vertex for cycle detection
     int cycleDetected = 0;
     for (int i = 0; i < totalVertices; i++) {
-        if (!visited[i]) {
-            if (detectCycle(adjMatrix, i, visited, recStack, labels, path, 0, totalVertices)) {
+        if (!bitsetTest(visited, i)) {
+            if (detectCycle(&adjMatrix, i, visited, onStack, &labels, frames)) {
                 cycleDetected = 1;
                 break;
             }
@@ -117,14 +127,11 @@ int main() {
     }
 
     // Free allocated memory
-    for (int i = 0; i < totalVertices; i++) {
-        free(adjMatrix[i]);
-    }
-    free(adjMatrix);
+    bmFree(&adjMatrix);
     free(visited);
-    free(recStack);
-    free(path);
-    free(labels);
+    free(onStack);
+    free(frames);
+    internFree(&labels);
 
     return 0;
 }
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/cycle_report.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/parallel_dfs.h"
+#include "../GRAPH CORE/wait_for.h"
+
+// Usage: DFS_PAR [--wait-for] [threads]   (defaults to one thread per online core)
+// Build: gcc -O2 -pthread DFS_PAR.c
+// --wait-for searches the wait-for projection, with single-instance
+// resources folded into process -> process edges.
+int main(int argc, char* argv[]) {
+    int numProcesses, numResources, edges;
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int waitFor = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--wait-for") == 0) {
+            waitFor = 1;
+        } else {
+            numThreads = atoi(argv[i]);
+        }
+    }
+
+    printf("Enter the number of processes, resources, and edges:\n");
+    scanf("%d %d %d", &numProcesses, &numResources, &edges);
+
+    int totalVertices = numProcesses + numResources;
+
+    // Input process and resource labels, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    int processCount = labels.count;
+    printf("Enter resource labels:\n");
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    // Edge stream, compressed into CSR once all edges are read
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int edgeCount = 0;
+
+    // Input edges
+    for (int i = 0; i < edges; i++) {
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+        printf("Enter edge (source and destination): ");
+        scanf("%63s %63s", src, dest);
+
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
+
+        if (srcIndex != -1 && destIndex != -1) {
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            edgeCount++;
+        }
+    }
+
+    CsrGraph graph;
+    if (csrBuild(&graph, totalVertices, edgeCount, srcList, destList, NULL) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    free(srcList);
+    free(destList);
+
+    // Optionally search the wait-for projection instead of the full graph
+    WaitForGraph wfg;
+    const WaitForGraph* projection = NULL;
+    const CsrGraph* search = &graph;
+    if (waitFor) {
+        if (waitForProject(&graph, processCount, &wfg) != 0) {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+        printf("\nWait-for graph: %d of %d vertices kept, %d resource(s) folded into edges.\n",
+               wfg.graph.numVertices, totalVertices, wfg.collapsed);
+        projection = &wfg;
+        search = &wfg.graph;
+        totalVertices = wfg.graph.numVertices;
+    }
+
+    // Explore from many roots at once; the first thread to confirm a cycle stops the rest
+    int witness = -1;
+    int result = parallelDetectCycle(search, numThreads, &witness);
+    if (result < 0) {
+        printf("Parallel detection failed\n");
+        return 1;
+    }
+
+    // Witness lies on a cycle, so a sequential DFS from it recovers a path to print
+    int cycleDetected = 0;
+    if (result == 1) {
+        unsigned char* state = (unsigned char*)calloc(totalVertices, sizeof(unsigned char));
+        DfsFrame* frames = (DfsFrame*)malloc(totalVertices * sizeof(DfsFrame));
+        int* cycle = (int*)malloc(totalVertices * sizeof(int));
+        int* expanded = (int*)malloc((2 * totalVertices + 1) * sizeof(int));
+        if (!state || !frames || !cycle || !expanded) {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+        // The witness depends on thread timing, so print from the cycle's smallest id
+        int* found;
+        int cycleLength = cycleFindFrom(search, witness, state, frames, cycle, projection, expanded, &found);
+        if (cycleLength > 0) {
+            cycleRotateToMin(found, cycleLength);
+            cycleReportPrint(&labels, found, cycleLength);
+            cycleDetected = 1;
+        }
+        free(state);
+        free(frames);
+        free(cycle);
+        free(expanded);
+    }
+
+    if (!cycleDetected) {
+        printf("No deadlock detected.\n");
+    } else {
+        printf("Deadlock detected (cycle exists).\n");
+    }
+
+    // Free allocated memory
+    csrFree(&graph);
+    if (waitFor) {
+        waitForFree(&wfg);
+    }
+    internFree(&labels);
+
+    return 0;
+}
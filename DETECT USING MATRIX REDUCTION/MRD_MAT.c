@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/matrix_reduction.h"
+
+// Function to read rows x numResources non-negative counts into a padded matrix.
+// Returns 0 on success, -1 on a missing or negative entry.
+int readMatrix(int* matrix, int rows, int numResources, int stride) {
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < numResources; j++) {
+            int* entry = &matrix[(size_t)i * stride + j];
+            if (scanf("%d", entry) != 1 || *entry < 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+// Reads process and resource names, then the Available vector and the
+// Allocation and Request matrices (one row per process, one column per
+// resource type), and reports the processes that can never finish.
+int main() {
+    int numProcesses, numResources;
+    char name[MAX_NAME_LENGTH];
+
+    printf("Enter number of processes and resource types: ");
+    if (scanf("%d %d", &numProcesses, &numResources) != 2 || numProcesses < 0 || numResources < 0) {
+        printf("Invalid input\n");
+        exit(1);
+    }
+
+    InternTable processNames, resourceNames;
+    if (internInit(&processNames, numProcesses) != 0 || internInit(&resourceNames, numResources) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    printf("Enter process names: ");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        if (internLookup(&processNames, name) != -1 || internAdd(&processNames, name) == -1) {
+            printf("Invalid process name: %s\n", name);
+            exit(1);
+        }
+    }
+
+    printf("Enter resource names: ");
+    for (int j = 0; j < numResources; j++) {
+        scanf("%63s", name);
+        if (internLookup(&resourceNames, name) != -1 || internAdd(&resourceNames, name) == -1) {
+            printf("Invalid resource name: %s\n", name);
+            exit(1);
+        }
+    }
+
+    int stride = matrixStride(numResources);
+    int* available = matrixCreate(1, stride);
+    int* allocation = matrixCreate(numProcesses, stride);
+    int* request = matrixCreate(numProcesses, stride);
+    unsigned char* finished = (unsigned char*)malloc(numProcesses + 1);
+    if (!available || !allocation || !request || !finished) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    printf("Enter available units per resource:\n");
+    if (readMatrix(available, 1, numResources, stride) != 0) {
+        printf("Invalid available vector\n");
+        exit(1);
+    }
+    printf("Enter allocation matrix:\n");
+    if (readMatrix(allocation, numProcesses, numResources, stride) != 0) {
+        printf("Invalid allocation matrix\n");
+        exit(1);
+    }
+    printf("Enter request matrix:\n");
+    if (readMatrix(request, numProcesses, numResources, stride) != 0) {
+        printf("Invalid request matrix\n");
+        exit(1);
+    }
+
+    int deadlocked = matrixReduce(available, allocation, request, numProcesses, numResources, finished, NULL);
+    if (deadlocked < 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    if (deadlocked == 0) {
+        printf("\nNo deadlock detected: all %d process(es) can finish\n", numProcesses);
+    } else {
+        printf("\nDeadlock detected among %d of %d process(es): ", deadlocked, numProcesses);
+        for (int i = 0; i < numProcesses; i++) {
+            if (!finished[i]) {
+                printf("%s ", internName(&processNames, i));
+            }
+        }
+        printf("\n");
+    }
+
+    // Free dynamically allocated memory
+    internFree(&processNames);
+    internFree(&resourceNames);
+    free(available);
+    free(allocation);
+    free(request);
+    free(finished);
+
+    return 0;
+}
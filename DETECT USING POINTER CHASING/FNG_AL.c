@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/cycle_report.h"
+#include "../GRAPH CORE/functional_graph.h"
+#include "../GRAPH CORE/intern_table.h"
+
+// What printCycle needs to walk and name a cycle
+typedef struct {
+    const int* next;
+    const InternTable* labels;
+} CyclePrinter;
+
+// Function to print the cycle through entry by following next
+int printCycle(int entry, void* context) {
+    const CyclePrinter* printer = (const CyclePrinter*)context;
+    printf("Cycle detected: %s", internName(printer->labels, entry));
+    for (int v = printer->next[entry]; v != entry; v = printer->next[v]) {
+        printf(" -> %s", internName(printer->labels, v));
+    }
+    printf(" -> %s\n", internName(printer->labels, entry));
+    return 0;  // Keep searching
+}
+
+// Function to fall back to the general DFS when some vertex waits on two others
+int detectWithDfs(int totalVertices, int edgeCount, const int* srcList, const int* destList, const InternTable* labels) {
+    CsrGraph graph;
+    unsigned char* state = (unsigned char*)calloc(totalVertices + 1, sizeof(unsigned char));
+    DfsFrame* frames = (DfsFrame*)malloc((totalVertices + 1) * sizeof(DfsFrame));
+    int* cycle = (int*)malloc((totalVertices + 1) * sizeof(int));
+    if (!state || !frames || !cycle || csrBuild(&graph, totalVertices, edgeCount, srcList, destList, NULL) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    int cycleLength = 0;
+    for (int i = 0; i < totalVertices && cycleLength == 0; i++) {
+        if (state[i] == DFS_UNVISITED) {
+            cycleLength = csrFindCycleFrom(&graph, i, state, frames, cycle);
+        }
+    }
+    if (cycleLength > 0) {
+        cycleReportPrint(labels, cycle, cycleLength);
+    }
+
+    csrFree(&graph);
+    free(state);
+    free(frames);
+    free(cycle);
+    return cycleLength > 0;
+}
+
+// Function to insert the edges one at a time, reporting each cycle as it closes.
+// Returns the number of cycles, or -1 at the first vertex with a second out-edge.
+int detectOnline(int totalVertices, int edgeCount, const int* srcList, const int* destList, const InternTable* labels) {
+    FunctionalForest forest;
+    if (functionalForestInit(&forest, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    int cycles = 0;
+    CyclePrinter printer = {forest.next, labels};
+    for (int i = 0; i < edgeCount && cycles >= 0; i++) {
+        int result = functionalForestInsert(&forest, srcList[i], destList[i]);
+        if (result == 1) {
+            printf("Edge %d closes a cycle. ", i + 1);
+            printCycle(destList[i], &printer);
+            cycles++;
+        } else if (result == -1) {
+            printf("%s waits on more than one vertex; online mode needs a functional graph.\n",
+                   internName(labels, srcList[i]));
+            cycles = -1;
+        }
+    }
+
+    functionalForestFree(&forest);
+    return cycles;
+}
+
+// Usage: FNG_AL [--online]
+// The default mode reads every edge, then finds all cycles by pointer chasing,
+// falling back to DFS if some vertex has two out-edges. --online checks each
+// edge as it arrives with a union-find forest.
+int main(int argc, char* argv[]) {
+    int numProcesses, numResources, edges;
+    int online = (argc > 1 && strcmp(argv[1], "--online") == 0);
+
+    printf("Enter the number of processes, resources, and edges:\n");
+    scanf("%d %d %d", &numProcesses, &numResources, &edges);
+
+    int totalVertices = numProcesses + numResources;
+
+    // Input process and resource labels, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    printf("Enter resource labels:\n");
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int* next = (int*)malloc((totalVertices + 1) * sizeof(int));
+    int* mark = (int*)malloc((totalVertices + 1) * sizeof(int));
+    if (!srcList || !destList || !next || !mark) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    int edgeCount = 0;
+
+    // Input edges
+    for (int i = 0; i < edges; i++) {
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+        printf("Enter edge (source and destination): ");
+        scanf("%63s %63s", src, dest);
+
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
+
+        if (srcIndex != -1 && destIndex != -1) {
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            edgeCount++;
+        }
+    }
+    printf("\n");
+
+    int cycles;
+    if (online) {
+        cycles = detectOnline(totalVertices, edgeCount, srcList, destList, &labels);
+    } else {
+        int branching = functionalFromEdges(totalVertices, edgeCount, srcList, destList, next);
+        if (branching == -1) {
+            CyclePrinter printer = {next, &labels};
+            cycles = functionalFindCycles(next, totalVertices, mark, printCycle, &printer);
+        } else {
+            printf("%s waits on more than one vertex; falling back to DFS.\n", internName(&labels, branching));
+            cycles = detectWithDfs(totalVertices, edgeCount, srcList, destList, &labels);
+        }
+    }
+
+    if (cycles > 0) {
+        printf("Deadlock detected (cycle exists).\n");
+    } else if (cycles == 0) {
+        printf("No deadlock detected.\n");
+    }
+
+    // Free allocated memory
+    internFree(&labels);
+    free(srcList);
+    free(destList);
+    free(next);
+    free(mark);
+
+    return 0;
+}
@@ -1,126 +1,81 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-#define MAX_VERTICES 52  // For lowercase a-z (processes) and uppercase A-Z (resources)
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/kahn.h"
+#include "../GRAPH CORE/wait_for.h"
 
-typedef struct Node {
-    int vertex;
-    struct Node* next;
-} Node;
-
-// Function to create a new node
-Node* createNode(int v) {
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    newNode->vertex = v;
-    newNode->next = NULL;
-    return newNode;
-}
-
-// Function to create an adjacency list for the graph
-Node** createAdjList(int size) {
-    Node** adjList = (Node**)malloc(size * sizeof(Node));
-    for (int i = 0; i < size; i++) {
-        adjList[i] = NULL;
-    }
-    return adjList;
-}
-
-// Function to add an edge to the adjacency list
-void addEdge(Node** adjList, int src, int dest) {
-    Node* newNode = createNode(dest);
-    newNode->next = adjList[src];
-    adjList[src] = newNode;
-}
-
-// Function to find the index of a vertex in labels array
-int findIndex(char* labels, int size, char vertex) {
-    for (int i = 0; i < size; i++) {
-        if (labels[i] == vertex) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-// Function to initialize and return the adjacency list for the graph
-Node** createGraph(int numProcesses, int numResources, int edges, char* labels) {
-    int totalVertices = numProcesses + numResources;
-    Node** adjList = createAdjList(totalVertices);
+// Function to read the edges and build the CSR graph
+CsrGraph createGraph(int edges, const InternTable* labels) {
+    int totalVertices = labels->count;
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int edgeCount = 0;
 
     // Input edges
     for (int i = 0; i < edges; i++) {
-        char src, dest;
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
         printf("Enter edge (src dest): ");
-        scanf(" %c %c", &src, &dest);
+        scanf("%63s %63s", src, dest);
 
-        int srcIndex = findIndex(labels, totalVertices, src);
-        int destIndex = findIndex(labels, totalVertices, dest);
+        int srcIndex = internLookup(labels, src);
+        int destIndex = internLookup(labels, dest);
 
         if (srcIndex != -1 && destIndex != -1) {
-            addEdge(adjList, srcIndex, destIndex);
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            edgeCount++;
         }
     }
 
-    return adjList;
-}
-
-// Kahn's Algorithm for topological sorting and cycle detection
-int kahn_topological_sort(Node** adjList, char* labels, int totalVertices) {
-    int in_degree[MAX_VERTICES] = {0};
-    int queue[MAX_VERTICES];
-    int front = 0, rear = 0;
-    int topological_order[MAX_VERTICES];
-    int top_order_index = 0;
-
-    // Calculate in-degrees for each vertex
-    for (int i = 0; i < totalVertices; i++) {
-        Node* temp = adjList[i];
-        while (temp) {
-            in_degree[temp->vertex]++;
-            temp = temp->next;
-        }
+    CsrGraph graph;
+    if (csrBuild(&graph, totalVertices, edgeCount, srcList, destList, NULL) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
     }
+    free(srcList);
+    free(destList);
 
-    // Enqueue vertices with zero in-degree
-    for (int i = 0; i < totalVertices; i++) {
-        if (in_degree[i] == 0) {
-            queue[rear++] = i;
-        }
-    }
+    return graph;
+}
 
-    // Process each vertex in the queue
-    while (front < rear) {
-        int current = queue[front++];
-        topological_order[top_order_index++] = current;
-
-        Node* temp = adjList[current];
-        while (temp) {
-            int adjVertex = temp->vertex;
-            in_degree[adjVertex]--;
-            if (in_degree[adjVertex] == 0) {
-                queue[rear++] = adjVertex;
-            }
-            temp = temp->next;
-        }
+// Kahn's Algorithm for topological sorting and cycle detection.
+// original maps vertices of a wait-for projection back to labels, NULL if none.
+int kahn_topological_sort(const CsrGraph* graph, const InternTable* labels, int totalVertices, const int* original) {
+    int* topological_order = (int*)malloc((totalVertices + 1) * sizeof(int));
+    int top_order_index = topological_order ? csrKahnOrder(graph, topological_order) : -1;
+    if (top_order_index < 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
     }
 
     // If top_order_index is not equal to totalVertices, there is a cycle
     if (top_order_index != totalVertices) {
         printf("Deadlock detected (cycle exists).\n");
+        free(topological_order);
         return -1;
     }
 
     printf("Topological Order: ");
     for (int i = 0; i < top_order_index; i++) {
-        printf("%c ", labels[topological_order[i]]);
+        int vertex = topological_order[i];
+        printf("%s ", internName(labels, original ? original[vertex] : vertex));
     }
     printf("\n");
 
+    free(topological_order);
+
     return 0;
 }
 
-int main() {
+// Usage: topoAL [--wait-for]
+// --wait-for sorts the wait-for projection, with single-instance resources
+// folded into process -> process edges.
+int main(int argc, char* argv[]) {
     int numProcesses, numResources, edges;
+    int waitFor = (argc > 1 && strcmp(argv[1], "--wait-for") == 0);
 
     // Input for the number of processes, resources, and edges
     printf("Enter number of processes, resources, and edges:\n");
@@ -128,38 +83,59 @@ int main() {
 
     int totalVertices = numProcesses + numResources;
 
-    // Initialize labels for vertices
-    char labels[MAX_VERTICES];
-    printf("Enter process labels (lowercase a-z):\n");
+    // Initialize labels for vertices, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
     for (int i = 0; i < numProcesses; i++) {
-        scanf(" %c", &labels[i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
-    printf("Enter resource labels (uppercase A-Z):\n");
+    int processCount = labels.count;
+    printf("Enter resource labels:\n");
     for (int i = 0; i < numResources; i++) {
-        scanf(" %c", &labels[numProcesses + i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    // Create the CSR graph
+    printf("Enter edges as pairs of labels (src dest):\n");
+    CsrGraph graph = createGraph(edges, &labels);
+
+    // Optionally sort the wait-for projection instead of the full graph
+    WaitForGraph wfg;
+    const CsrGraph* sorted = &graph;
+    const int* original = NULL;
+    if (waitFor) {
+        if (waitForProject(&graph, processCount, &wfg) != 0) {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+        printf("Wait-for graph: %d of %d vertices kept, %d resource(s) folded into edges.\n",
+               wfg.graph.numVertices, totalVertices, wfg.collapsed);
+        sorted = &wfg.graph;
+        original = wfg.original;
+        totalVertices = wfg.graph.numVertices;
     }
 
-    // Create the adjacency list
-    printf("Enter edges as pairs of characters (src dest):\n");
-    Node** graph = createGraph(numProcesses, numResources, edges, labels);
-
-    // Perform Kahn's algorithm on the created adjacency list
-    if (kahn_topological_sort(graph, labels, totalVertices) == 0) {
+    // Perform Kahn's algorithm on the created CSR graph
+    if (kahn_topological_sort(sorted, &labels, totalVertices, original) == 0) {
         printf("No deadlock detected.\n");
     } else {
         printf("System is in a deadlock state.\n");
     }
 
     // Free allocated memory
-    for (int i = 0; i < totalVertices; i++) {
-        Node* temp = graph[i];
-        while (temp) {
-            Node* toFree = temp;
-            temp = temp->next;
-            free(toFree);
-        }
+    internFree(&labels);
+    csrFree(&graph);
+    if (waitFor) {
+        waitForFree(&wfg);
     }
-    free(graph);
 
     return 0;
 }
\ No newline at end of file
@@ -1,46 +1,29 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#define MAX_VERTICES 52  // For lowercase a-z (processes) and uppercase A-Z (resources)
-
-// Function to initialize and return an adjacency matrix for the graph
-int** createAdjMatrix(int size) {
-    int** adjMatrix = (int**)malloc(size * sizeof(int*));
-    for (int i = 0; i < size; i++) {
-        adjMatrix[i] = (int*)malloc(size * sizeof(int));
-        for (int j = 0; j < size; j++) {
-            adjMatrix[i][j] = 0;  // Initialize all entries to 0
-        }
+#include "../GRAPH CORE/bit_matrix.h"
+#include "../GRAPH CORE/intern_table.h"
+
+// Function to initialize and populate the bit-packed adjacency matrix for the graph
+BitMatrix createGraph(int edges, const InternTable* labels) {
+    int totalVertices = labels->count;
+    BitMatrix adjMatrix;
+    if (bmCreate(&adjMatrix, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
     }
-    return adjMatrix;
-}
-
-// Function to find the index of a vertex in the labels array
-int findIndex(char* labels, int size, char vertex) {
-    for (int i = 0; i < size; i++) {
-        if (labels[i] == vertex) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-// Function to initialize and populate the adjacency matrix for the graph
-int** createGraph(int numProcesses, int numResources, int edges, char* labels) {
-    int totalVertices = numProcesses + numResources;
-    int** adjMatrix = createAdjMatrix(totalVertices);
 
     // Input edges
     for (int i = 0; i < edges; i++) {
-        char src, dest;
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
         printf("Enter edge (src dest): ");
-        scanf(" %c %c", &src, &dest);
+        scanf("%63s %63s", src, dest);
 
-        int srcIndex = findIndex(labels, totalVertices, src);
-        int destIndex = findIndex(labels, totalVertices, dest);
+        int srcIndex = internLookup(labels, src);
+        int destIndex = internLookup(labels, dest);
 
         if (srcIndex != -1 && destIndex != -1) {
-            adjMatrix[srcIndex][destIndex] = 1;  // Add edge
+            bmSet(&adjMatrix, srcIndex, destIndex);  // Add edge
         }
     }
 
@@ -48,21 +31,15 @@ int** createGraph(int numProcesses, int numResources, int edges, char* labels) {
 }
 
 // Kahn's Algorithm for topological sorting and cycle detection
-int kahn_topological_sort(int** adjMatrix, char* labels, int totalVertices) {
-    int in_degree[MAX_VERTICES] = {0};
-    int queue[MAX_VERTICES];
+int kahn_topological_sort(const BitMatrix* adjMatrix, const InternTable* labels, int totalVertices) {
+    int* in_degree = (int*)calloc(totalVertices + 1, sizeof(int));
+    int* queue = (int*)malloc((totalVertices + 1) * sizeof(int));
     int front = 0, rear = 0;
-    int topological_order[MAX_VERTICES];
+    int* topological_order = (int*)malloc((totalVertices + 1) * sizeof(int));
     int top_order_index = 0;
 
-    // Calculate in-degrees for each vertex
-    for (int i = 0; i < totalVertices; i++) {
-        for (int j = 0; j < totalVertices; j++) {
-            if (adjMatrix[i][j] == 1) {
-                in_degree[j]++;
-            }
-        }
-    }
+    // Calculate in-degrees for each vertex as column sums over set bits
+    bmColumnCounts(adjMatrix, in_degree);
 
     // Enqueue vertices with zero in-degree
     for (int i = 0; i < totalVertices; i++) {
@@ -76,12 +53,10 @@ int kahn_topological_sort(int** adjMatrix, char* labels, int totalVertices) {
         int current = queue[front++];
         topological_order[top_order_index++] = current;
 
-        for (int i = 0; i < totalVertices; i++) {
-            if (adjMatrix[current][i] == 1) {
-                in_degree[i]--;
-                if (in_degree[i] == 0) {
-                    queue[rear++] = i;
-                }
+        for (int i = bmNextInRow(adjMatrix, current, 0); i != -1; i = bmNextInRow(adjMatrix, current, i + 1)) {
+            in_degree[i]--;
+            if (in_degree[i] == 0) {
+                queue[rear++] = i;
             }
         }
     }
@@ -89,15 +64,22 @@ int kahn_topological_sort(int** adjMatrix, char* labels, int totalVertices) {
     // If top_order_index is not equal to totalVertices, there is a cycle
     if (top_order_index != totalVertices) {
         printf("Deadlock detected (cycle exists).\n");
+        free(in_degree);
+        free(queue);
+        free(topological_order);
         return -1;
     }
 
     printf("Topological Order: ");
     for (int i = 0; i < top_order_index; i++) {
-        printf("%c ", labels[topological_order[i]]);
+        printf("%s ", internName(labels, topological_order[i]));
     }
     printf("\n");
 
+    free(in_degree);
+    free(queue);
+    free(topological_order);
+
     return 0;
 }
 
@@ -110,33 +92,39 @@ int main() {
 
     int totalVertices = numProcesses + numResources;
 
-    // Initialize labels for vertices
-    char labels[MAX_VERTICES];
-    printf("Enter process labels (lowercase a-z):\n");
+    // Initialize labels for vertices, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
     for (int i = 0; i < numProcesses; i++) {
-        scanf(" %c", &labels[i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
-    printf("Enter resource labels (uppercase A-Z):\n");
+    printf("Enter resource labels:\n");
     for (int i = 0; i < numResources; i++) {
-        scanf(" %c", &labels[numProcesses + i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
+    totalVertices = labels.count;  // Repeated labels share one vertex
 
     // Create the adjacency matrix
-    printf("Enter edges as pairs of characters (src dest):\n");
-    int** graph = createGraph(numProcesses, numResources, edges, labels);
+    printf("Enter edges as pairs of labels (src dest):\n");
+    BitMatrix graph = createGraph(edges, &labels);
 
     // Perform Kahn's algorithm on the created adjacency matrix
-    if (kahn_topological_sort(graph, labels, totalVertices) == 0) {
+    if (kahn_topological_sort(&graph, &labels, totalVertices) == 0) {
         printf("No deadlock detected.\n");
     } else {
         printf("System is in a deadlock state.\n");
     }
 
     // Free allocated memory
-    for (int i = 0; i < totalVertices; i++) {
-        free(graph[i]);
-    }
-    free(graph);
+    internFree(&labels);
+    bmFree(&graph);
 
     return 0;
 }
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/dynamic_graph.h"
+
+// Function to print every deadlocked component, one run of the order at a time
+void printDeadlocks(const DynamicGraph* graph, const InternTable* labels) {
+    for (int p = 0; p < graph->numVertices; p++) {
+        int v = graph->node[p];
+        if (!graph->cyclicLeader[v]) {
+            continue;
+        }
+        printf("Deadlock detected:");
+        for (int q = p; q < graph->numVertices && graph->sccId[graph->node[q]] == graph->sccId[v]; q++) {
+            printf(" %s", internName(labels, graph->node[q]));
+        }
+        printf("\n");
+    }
+}
+
+// Function to refresh the lazily invalidated components and report the state
+void checkDeadlock(DynamicGraph* graph, const InternTable* labels) {
+    int rechecked = dgRefresh(graph);
+    printf("Rechecked %d vertex(es).\n", rechecked);
+    if (graph->cyclicCount == 0) {
+        printf("No deadlock detected.\n");
+        return;
+    }
+    printDeadlocks(graph, labels);
+    printf("System is in a deadlock state.\n");
+}
+
+// Function to apply one request (+) or release (-) of an edge
+void applyOperation(DynamicGraph* graph, const InternTable* labels, char op, const char* src, const char* dest) {
+    int srcIndex = internLookup(labels, src);
+    int destIndex = internLookup(labels, dest);
+    if (srcIndex == -1 || destIndex == -1) {
+        printf("Invalid edge: %s -> %s\n", src, dest);
+        return;
+    }
+
+    int result = op == '+' ? dgInsertEdge(graph, srcIndex, destIndex) : dgDeleteEdge(graph, srcIndex, destIndex);
+    if (result < 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+    if (result == 0) {
+        printf(op == '+' ? "Edge already present: %s -> %s\n" : "No such edge: %s -> %s\n", src, dest);
+    }
+}
+
+int main() {
+    int numProcesses, numResources, edges;
+
+    // Input for the number of processes, resources, and edges
+    printf("Enter number of processes, resources, and edges:\n");
+    scanf("%d %d %d", &numProcesses, &numResources, &edges);
+
+    int totalVertices = numProcesses + numResources;
+
+    // Initialize labels for vertices, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    printf("Enter resource labels:\n");
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    DynamicGraph graph;
+    if (dgInit(&graph, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+
+    // Initial edges are plain insertions
+    char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+    printf("Enter edges as pairs of labels (src dest):\n");
+    for (int i = 0; i < edges; i++) {
+        printf("Enter edge (src dest): ");
+        scanf("%63s %63s", src, dest);
+        applyOperation(&graph, &labels, '+', src, dest);
+    }
+    printf("\n");
+    checkDeadlock(&graph, &labels);
+
+    // Then a stream of operations until EOF
+    printf("Enter operations (+ src dest, - src dest, ? to check), end with EOF:\n");
+    char op[4];
+    while (scanf("%3s", op) == 1) {
+        if (op[0] == '?') {
+            checkDeadlock(&graph, &labels);
+        } else if ((op[0] == '+' || op[0] == '-') && op[1] == '\0' && scanf("%63s %63s", src, dest) == 2) {
+            applyOperation(&graph, &labels, op[0], src, dest);
+        } else {
+            printf("Invalid operation: %s\n", op);
+        }
+    }
+
+    // Free allocated memory
+    dgFree(&graph);
+    internFree(&labels);
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/kahn.h"
+#include "../GRAPH CORE/incremental_topo.h"
+
+// Function to read the initial edges into parallel source/destination lists
+int readEdges(int edges, const InternTable* labels, int* srcList, int* destList) {
+    int edgeCount = 0;
+
+    for (int i = 0; i < edges; i++) {
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+        printf("Enter edge (src dest): ");
+        scanf("%63s %63s", src, dest);
+
+        int srcIndex = internLookup(labels, src);
+        int destIndex = internLookup(labels, dest);
+
+        if (srcIndex != -1 && destIndex != -1) {
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            edgeCount++;
+        }
+    }
+
+    return edgeCount;
+}
+
+// Function to print a rejected request together with the cycle it would close
+void printCycle(const InternTable* labels, const int* cycle, int length) {
+    printf("Request denied (deadlock): ");
+    for (int i = 0; i < length; i++) {
+        printf("%s -> ", internName(labels, cycle[i]));
+    }
+    printf("%s\n", internName(labels, cycle[0]));
+}
+
+int main() {
+    int numProcesses, numResources, edges;
+
+    // Input for the number of processes, resources, and edges
+    printf("Enter number of processes, resources, and edges:\n");
+    scanf("%d %d %d", &numProcesses, &numResources, &edges);
+
+    int totalVertices = numProcesses + numResources;
+
+    // Initialize labels for vertices, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    printf("Enter resource labels:\n");
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    // Read the initial graph and order it once with Kahn's algorithm
+    printf("Enter edges as pairs of labels (src dest):\n");
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int* order = (int*)malloc((totalVertices + 1) * sizeof(int));
+    int* cycle = (int*)malloc((totalVertices + 1) * sizeof(int));
+    if (!srcList || !destList || !order || !cycle) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    int edgeCount = readEdges(edges, &labels, srcList, destList);
+
+    CsrGraph graph;
+    if (csrBuild(&graph, totalVertices, edgeCount, srcList, destList, NULL) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    int orderedCount = csrKahnOrder(&graph, order);
+    if (orderedCount < 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    if (orderedCount != totalVertices) {
+        printf("\nDeadlock detected (cycle exists).\n");
+        printf("System is in a deadlock state.\n");
+        csrFree(&graph);
+        internFree(&labels);
+        free(srcList);
+        free(destList);
+        free(order);
+        free(cycle);
+        return 0;
+    }
+    printf("\nNo deadlock detected.\n");
+
+    // Seed the dynamic order; every initial edge already respects it
+    IncrementalTopo topo;
+    if (itInit(&topo, totalVertices, order) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    for (int e = 0; e < edgeCount; e++) {
+        if (itAddEdgeUnchecked(&topo, srcList[e], destList[e]) != 0) {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+    }
+
+    // Check each further request online; a request that would close a
+    // cycle is refused and the graph is left unchanged
+    printf("Enter requests as pairs of labels (src dest), end with EOF:\n");
+    char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+    int granted = 0, denied = 0;
+    while (scanf("%63s %63s", src, dest) == 2) {
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
+        if (srcIndex == -1 || destIndex == -1) {
+            printf("Invalid edge: %s -> %s\n", src, dest);
+            continue;
+        }
+
+        int length = 0;
+        int result = itInsertEdge(&topo, srcIndex, destIndex, cycle, &length);
+        if (result < 0) {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+        if (result == 1) {
+            printf("Request granted: %s -> %s\n", src, dest);
+            granted++;
+        } else {
+            printCycle(&labels, cycle, length);
+            denied++;
+        }
+    }
+    printf("%d request(s) granted, %d denied.\n", granted, denied);
+
+    // Free allocated memory
+    itFree(&topo);
+    csrFree(&graph);
+    internFree(&labels);
+    free(srcList);
+    free(destList);
+    free(order);
+    free(cycle);
+
+    return 0;
+}
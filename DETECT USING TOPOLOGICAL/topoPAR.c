@@ -0,0 +1,152 @@
+#define _POSIX_C_SOURCE 200112L  // pthread_barrier_t under -std=c11
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/kahn_parallel.h"
+#include "../GRAPH CORE/wait_for.h"
+
+// Function to read the edges and build the CSR graph
+CsrGraph createGraph(int edges, const InternTable* labels) {
+    int totalVertices = labels->count;
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int edgeCount = 0;
+
+    // Input edges
+    for (int i = 0; i < edges; i++) {
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+        printf("Enter edge (src dest): ");
+        scanf("%63s %63s", src, dest);
+
+        int srcIndex = internLookup(labels, src);
+        int destIndex = internLookup(labels, dest);
+
+        if (srcIndex != -1 && destIndex != -1) {
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            edgeCount++;
+        }
+    }
+
+    CsrGraph graph;
+    if (csrBuild(&graph, totalVertices, edgeCount, srcList, destList, NULL) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+    free(srcList);
+    free(destList);
+
+    return graph;
+}
+
+// Kahn's Algorithm, one frontier level at a time across numThreads threads.
+// original maps vertices of a wait-for projection back to labels, NULL if none.
+int kahn_topological_sort(const CsrGraph* graph, const InternTable* labels, int totalVertices, int numThreads, const int* original) {
+    int* topological_order = (int*)malloc((totalVertices + 1) * sizeof(int));
+    int top_order_index = topological_order ? csrParallelKahnOrder(graph, numThreads, topological_order) : -1;
+    if (top_order_index < 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
+
+    // If top_order_index is not equal to totalVertices, there is a cycle
+    if (top_order_index != totalVertices) {
+        printf("Deadlock detected (cycle exists).\n");
+        free(topological_order);
+        return -1;
+    }
+
+    printf("Topological Order: ");
+    for (int i = 0; i < top_order_index; i++) {
+        int vertex = topological_order[i];
+        printf("%s ", internName(labels, original ? original[vertex] : vertex));
+    }
+    printf("\n");
+
+    free(topological_order);
+
+    return 0;
+}
+
+// Usage: topoPAR [--wait-for] [threads]   (defaults to one thread per online core)
+// --wait-for sorts the wait-for projection, with single-instance resources
+// folded into process -> process edges.
+int main(int argc, char* argv[]) {
+    int numProcesses, numResources, edges;
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int waitFor = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--wait-for") == 0) {
+            waitFor = 1;
+        } else {
+            numThreads = atoi(argv[i]);
+        }
+    }
+
+    // Input for the number of processes, resources, and edges
+    printf("Enter number of processes, resources, and edges:\n");
+    scanf("%d %d %d", &numProcesses, &numResources, &edges);
+
+    int totalVertices = numProcesses + numResources;
+
+    // Initialize labels for vertices, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    int processCount = labels.count;
+    printf("Enter resource labels:\n");
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    // Create the CSR graph
+    printf("Enter edges as pairs of labels (src dest):\n");
+    CsrGraph graph = createGraph(edges, &labels);
+
+    // Optionally sort the wait-for projection instead of the full graph
+    WaitForGraph wfg;
+    const CsrGraph* sorted = &graph;
+    const int* original = NULL;
+    if (waitFor) {
+        if (waitForProject(&graph, processCount, &wfg) != 0) {
+            printf("Memory allocation failed\n");
+            return 1;
+        }
+        printf("Wait-for graph: %d of %d vertices kept, %d resource(s) folded into edges.\n",
+               wfg.graph.numVertices, totalVertices, wfg.collapsed);
+        sorted = &wfg.graph;
+        original = wfg.original;
+        totalVertices = wfg.graph.numVertices;
+    }
+
+    // Perform the parallel Kahn's algorithm on the created CSR graph
+    if (kahn_topological_sort(sorted, &labels, totalVertices, numThreads, original) == 0) {
+        printf("No deadlock detected.\n");
+    } else {
+        printf("System is in a deadlock state.\n");
+    }
+
+    // Free allocated memory
+    internFree(&labels);
+    csrFree(&graph);
+    if (waitFor) {
+        waitForFree(&wfg);
+    }
+
+    return 0;
+}
\ No newline at end of file
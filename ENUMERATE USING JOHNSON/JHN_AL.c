@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/johnson_cycles.h"
+
+// Streaming writer: prints each deadlock cycle the moment Johnson finds it
+int printCycle(const int* cycle, int length, void* context) {
+    const InternTable* labels = (const InternTable*)context;
+    static long long cycleNumber = 0;
+
+    printf("Cycle %lld: ", ++cycleNumber);
+    for (int i = 0; i < length; i++) {
+        printf("%s -> ", internName(labels, cycle[i]));
+    }
+    printf("%s\n", internName(labels, cycle[0]));
+    return 0;  // Keep enumerating
+}
+
+// Usage: JHN_AL [maxCycles] [maxLength]   (0 or omitted means unlimited)
+int main(int argc, char* argv[]) {
+    int numProcesses, numResources, edges;
+    CycleLimits limits = {0, 0};
+
+    if (argc > 1) {
+        limits.maxCycles = atoll(argv[1]);
+    }
+    if (argc > 2) {
+        limits.maxLength = atoi(argv[2]);
+    }
+
+    printf("Enter the number of processes, resources, and edges:\n");
+    scanf("%d %d %d", &numProcesses, &numResources, &edges);
+
+    int totalVertices = numProcesses + numResources;
+
+    // Input process and resource labels, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    printf("Enter resource labels:\n");
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    // Edge stream, compressed into CSR once all edges are read
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int edgeCount = 0;
+
+    // Input edges
+    for (int i = 0; i < edges; i++) {
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+        printf("Enter edge (source and destination): ");
+        scanf("%63s %63s", src, dest);
+
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
+
+        if (srcIndex != -1 && destIndex != -1) {
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            edgeCount++;
+        }
+    }
+    printf("\n");
+
+    CsrGraph graph;
+    if (csrBuild(&graph, totalVertices, edgeCount, srcList, destList, NULL) != 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+    free(srcList);
+    free(destList);
+
+    // Enumerate every elementary cycle, per SCC, streaming each one out
+    long long cycleCount = johnsonEnumerate(&graph, &limits, printCycle, &labels);
+    if (cycleCount < 0) {
+        printf("Memory allocation failed\n");
+        return 1;
+    }
+
+    if (cycleCount == 0) {
+        printf("No deadlock detected.\n");
+    } else {
+        printf("Deadlock detected: %lld distinct cycle(s)", cycleCount);
+        if (limits.maxCycles > 0 && cycleCount >= limits.maxCycles) {
+            printf(" (stopped at the limit of %lld)", limits.maxCycles);
+        }
+        printf(".\n");
+    }
+
+    // Free allocated memory
+    csrFree(&graph);
+    internFree(&labels);
+
+    return 0;
+}
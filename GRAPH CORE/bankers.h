@@ -0,0 +1,319 @@
+#ifndef BANKERS_H
+#define BANKERS_H
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "matrix_reduction.h"
+
+// Deadlock avoidance with the Banker's algorithm: a request is granted only
+// if the state it leads to is safe, i.e. some order lets every process obtain
+// its full claim and finish. Matrices use the padded layout of
+// matrix_reduction.h, so every row test is a run of vector compares.
+//
+// The engine keeps the last safe sequence s_0 .. s_{n-1}. Let W_t be the free
+// units once s_0 .. s_{t-1} have finished. Granting r to the process at
+// position k takes r out of W_t for t <= k and out of that process's need,
+// but it hands r back when it finishes, so positions after k see the same
+// W_t as before. Only the prefix before k has to be walked again: the grant
+// is safe on the cached sequence if need[s_t] <= W_t - r for every t < k.
+// Releases only raise W_t, so they never invalidate the sequence. Only when
+// the prefix check fails does the engine search for a new sequence, using
+// the worklist reduction of matrixReduce instead of the O(n^2 m) scan.
+typedef struct {
+    int numProcesses;
+    int numResources;
+    int stride;
+    int* available;    // 1 x stride
+    int* allocation;   // numProcesses x stride
+    int* need;         // Remaining claim, numProcesses x stride
+    int* total;        // Units of each type, held or free
+    int* sequence;     // Cached safe sequence
+    int* candidate;    // Sequence being built by a full check, swapped in on success
+    int* position;     // Position of each process in the sequence
+    int* work;         // Scratch rows
+    int* order;
+    unsigned char* finished;
+    long long prefixChecks;
+    long long fullChecks;
+} BankerState;
+
+static inline void bankerFree(BankerState* state) {
+    free(state->available);
+    free(state->allocation);
+    free(state->need);
+    free(state->total);
+    free(state->sequence);
+    free(state->candidate);
+    free(state->position);
+    free(state->work);
+    free(state->order);
+    free(state->finished);
+    state->available = state->allocation = state->need = state->total = NULL;
+    state->sequence = state->candidate = state->position = state->work = state->order = NULL;
+    state->finished = NULL;
+}
+
+// Function to check row <= limit in every lane. Returns 1 or 0.
+static inline int bankerFits(const int* row, const int* limit, int stride) {
+    const MatrixLanes* rowLanes = (const MatrixLanes*)row;
+    const MatrixLanes* limitLanes = (const MatrixLanes*)limit;
+    MatrixLanes over = {0};
+    for (int k = 0; k < stride / MATRIX_LANES; k++) {
+        over |= rowLanes[k] > limitLanes[k];
+    }
+    return matrixLaneSum(over) == 0;
+}
+
+static inline void bankerAddRow(int* row, const int* delta, int stride) {
+    MatrixLanes* rowLanes = (MatrixLanes*)row;
+    const MatrixLanes* deltaLanes = (const MatrixLanes*)delta;
+    for (int k = 0; k < stride / MATRIX_LANES; k++) {
+        rowLanes[k] += deltaLanes[k];
+    }
+}
+
+static inline void bankerSubtractRow(int* row, const int* delta, int stride) {
+    MatrixLanes* rowLanes = (MatrixLanes*)row;
+    const MatrixLanes* deltaLanes = (const MatrixLanes*)delta;
+    for (int k = 0; k < stride / MATRIX_LANES; k++) {
+        rowLanes[k] -= deltaLanes[k];
+    }
+}
+
+// Function to search for a safe sequence from scratch and cache it.
+// Returns 1 if the state is safe, 0 if not (the cache is then left alone),
+// or -1 if allocation fails.
+static inline int bankerFullCheck(BankerState* state) {
+    int n = state->numProcesses, stride = state->stride;
+    state->fullChecks++;
+    int deadlocked = matrixReduce(state->available, state->allocation, state->need, n, state->numResources,
+                                  state->finished, state->order);
+    if (deadlocked != 0) {
+        return deadlocked < 0 ? -1 : 0;
+    }
+
+    // matrixReduce lists processes holding nothing first without testing
+    // them. They release nothing, so they can run last, once every unit is
+    // free, provided their claim fits in the total. The sequence is built
+    // aside, so a failure here leaves the cached one intact.
+    const int* zeroRow = state->total + stride;
+    int* candidate = state->candidate;
+    int count = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < n; i++) {
+            int p = state->order[i];
+            int holdsNothing = bankerFits(state->allocation + (size_t)p * stride, zeroRow, stride);
+            if (holdsNothing != pass) {
+                continue;
+            }
+            if (holdsNothing && !bankerFits(state->need + (size_t)p * stride, state->total, stride)) {
+                return 0;
+            }
+            candidate[count++] = p;
+        }
+    }
+    state->candidate = state->sequence;
+    state->sequence = candidate;
+    for (int t = 0; t < n; t++) {
+        state->position[state->sequence[t]] = t;
+    }
+    return 1;
+}
+
+// Function to set up the engine. The three matrices come from matrixCreate
+// with matrixStride(numResources) and are copied; need = maximum - allocation.
+// Returns 1 if the initial state is safe, 0 if it is not or some allocation
+// exceeds its claim, or -1 if allocation fails. Release with bankerFree.
+static inline int bankerInit(BankerState* state, const int* available, const int* maximum, const int* allocation,
+                             int numProcesses, int numResources) {
+    int n = numProcesses, stride = matrixStride(numResources);
+    size_t cells = (size_t)n * stride;
+    state->numProcesses = n;
+    state->numResources = numResources;
+    state->stride = stride;
+    state->prefixChecks = state->fullChecks = 0;
+    state->available = matrixCreate(1, stride);
+    state->allocation = matrixCreate(n, stride);
+    state->need = matrixCreate(n, stride);
+    state->total = matrixCreate(2, stride);  // Second row stays zero
+    state->work = matrixCreate(2, stride);
+    state->sequence = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    state->candidate = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    state->position = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    state->order = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    state->finished = (unsigned char*)malloc((size_t)n + 1);
+    if (!state->available || !state->allocation || !state->need || !state->total || !state->work ||
+        !state->sequence || !state->candidate || !state->position || !state->order || !state->finished) {
+        bankerFree(state);
+        return -1;
+    }
+
+    for (int j = 0; j < stride; j++) {
+        state->available[j] = state->total[j] = available[j];
+    }
+    for (size_t k = 0; k < cells; k++) {
+        state->allocation[k] = allocation[k];
+        state->need[k] = maximum[k] - allocation[k];
+        if (state->need[k] < 0) {
+            return 0;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        bankerAddRow(state->total, state->allocation + (size_t)i * stride, stride);
+    }
+    return bankerFullCheck(state);
+}
+
+// Function to check whether process p may take request (a padded row),
+// and to grant it if so. The caller ensures request <= need[p].
+// Returns 1 if granted, 0 if p must wait, or -1 if allocation fails.
+static inline int bankerRequest(BankerState* state, int p, const int* request) {
+    int stride = state->stride;
+    int* needRow = state->need + (size_t)p * stride;
+    int* allocationRow = state->allocation + (size_t)p * stride;
+    if (!bankerFits(request, state->available, stride)) {
+        return 0;
+    }
+
+    // Walk the cached sequence up to p with r taken out of the free units
+    state->prefixChecks++;
+    int* work = state->work;
+    for (int j = 0; j < stride; j++) {
+        work[j] = state->available[j] - request[j];
+    }
+    int safe = 1;
+    for (int t = 0; t < state->position[p]; t++) {
+        int q = state->sequence[t];
+        if (!bankerFits(state->need + (size_t)q * stride, work, stride)) {
+            safe = 0;
+            break;
+        }
+        bankerAddRow(work, state->allocation + (size_t)q * stride, stride);
+    }
+
+    bankerSubtractRow(state->available, request, stride);
+    bankerAddRow(allocationRow, request, stride);
+    bankerSubtractRow(needRow, request, stride);
+    if (!safe) {
+        safe = bankerFullCheck(state);
+        if (safe != 1) {
+            bankerAddRow(state->available, request, stride);
+            bankerSubtractRow(allocationRow, request, stride);
+            bankerAddRow(needRow, request, stride);
+        }
+    }
+    return safe;
+}
+
+// Function to hand units back. The cached sequence stays safe.
+// The caller ensures release <= allocation[p].
+static inline void bankerRelease(BankerState* state, int p, const int* release) {
+    int stride = state->stride;
+    bankerAddRow(state->available, release, stride);
+    bankerSubtractRow(state->allocation + (size_t)p * stride, release, stride);
+    bankerAddRow(state->need + (size_t)p * stride, release, stride);
+}
+
+// One request of a batch: its index and the position of its process
+typedef struct {
+    int position;
+    int request;
+} BankerPending;
+
+static inline int bankerPendingCompare(const void* a, const void* b) {
+    const BankerPending* x = (const BankerPending*)a;
+    const BankerPending* y = (const BankerPending*)b;
+    if (x->position != y->position) {
+        return x->position < y->position ? -1 : 1;
+    }
+    return y->request - x->request;
+}
+
+// Function to decide a batch of requests in one walk of the cached sequence.
+// Request b asks for requests[b * stride ..] on behalf of processes[b]; the
+// caller ensures each fits the claim of its process on its own. Granted
+// requests are applied and marked granted[b] = 1; the rest must wait and
+// can be retried with bankerRequest, which may find another safe sequence.
+//
+// Requests are decided from the latest sequence position to the earliest,
+// in arrival order within a position. Every grant accepted so far then sits
+// at or after the current position and lowers each earlier W_t by the same
+// amount, so one prefix minimum of W_t - need[s_t] per request, taken in a
+// single forward walk, settles it.
+// Returns the number granted, or -1 if allocation fails.
+static inline int bankerRequestBatch(BankerState* state, int count, const int* processes, const int* requests,
+                                     unsigned char* granted) {
+    int stride = state->stride, chunks = stride / MATRIX_LANES;
+    BankerPending* pending = (BankerPending*)malloc(((size_t)count + 1) * sizeof(BankerPending));
+    int* slack = matrixCreate(count, stride);
+    int* accepted = matrixCreate(1, stride);
+    if (!pending || !slack || !accepted) {
+        free(pending);
+        free(slack);
+        free(accepted);
+        return -1;
+    }
+    for (int b = 0; b < count; b++) {
+        pending[b].position = state->position[processes[b]];
+        pending[b].request = b;
+        granted[b] = 0;
+    }
+    qsort(pending, count, sizeof(BankerPending), bankerPendingCompare);
+
+    // Forward walk: snapshot the running minimum of W_t - need[s_t] over t < position
+    MatrixLanes* work = (MatrixLanes*)state->work;
+    MatrixLanes* minimum = (MatrixLanes*)(state->work + stride);
+    for (int j = 0; j < stride; j++) {
+        state->work[j] = state->available[j];
+        state->work[stride + j] = INT_MAX;
+    }
+    int t = 0;
+    for (int i = 0; i < count; i++) {
+        for (; t < pending[i].position; t++) {
+            int q = state->sequence[t];
+            const MatrixLanes* needLanes = (const MatrixLanes*)(state->need + (size_t)q * stride);
+            const MatrixLanes* allocationLanes = (const MatrixLanes*)(state->allocation + (size_t)q * stride);
+            for (int k = 0; k < chunks; k++) {
+                MatrixLanes rowSlack = work[k] - needLanes[k];
+                MatrixLanes lower = rowSlack < minimum[k];
+                minimum[k] = (rowSlack & lower) | (minimum[k] & ~lower);
+                work[k] += allocationLanes[k];
+            }
+        }
+        int* snapshot = slack + (size_t)i * stride;
+        for (int j = 0; j < stride; j++) {
+            snapshot[j] = state->work[stride + j];
+        }
+    }
+    if (count > 0) {
+        state->prefixChecks++;
+    }
+
+    // Backward decisions: earlier positions lose everything granted so far
+    int grants = 0;
+    for (int i = count - 1; i >= 0; i--) {
+        int b = pending[i].request, p = processes[b];
+        const int* request = requests + (size_t)b * stride;
+        int* room = state->work;
+        for (int j = 0; j < stride; j++) {
+            room[j] = slack[(size_t)i * stride + j] - accepted[j];
+        }
+        if (bankerFits(request, state->need + (size_t)p * stride, stride) &&
+            bankerFits(request, state->available, stride) && bankerFits(request, room, stride)) {
+            bankerSubtractRow(state->available, request, stride);
+            bankerAddRow(state->allocation + (size_t)p * stride, request, stride);
+            bankerSubtractRow(state->need + (size_t)p * stride, request, stride);
+            bankerAddRow(accepted, request, stride);
+            granted[b] = 1;
+            grants++;
+        }
+    }
+
+    free(pending);
+    free(slack);
+    free(accepted);
+    return grants;
+}
+
+#endif // BANKERS_H
@@ -0,0 +1,147 @@
+#ifndef BIT_MATRIX_H
+#define BIT_MATRIX_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// Dense adjacency matrix packed one bit per possible edge.
+// Rows are contiguous runs of 64-bit words in a single allocation, so a
+// neighbor scan reads 64 columns per load and skips empty words outright.
+typedef struct {
+    int size;
+    int wordsPerRow;
+    uint64_t* bits;  // size * wordsPerRow words, row-major
+} BitMatrix;
+
+// Number of 64-bit words needed to hold n bits
+static inline int bitWords(int n) {
+    return (n + 63) / 64;
+}
+
+// Function to allocate a zeroed bitset of n bits, NULL on failure
+static inline uint64_t* bitsetCreate(int n) {
+    return (uint64_t*)calloc((size_t)bitWords(n) + 1, sizeof(uint64_t));
+}
+
+static inline int bitsetTest(const uint64_t* set, int i) {
+    return (int)((set[i >> 6] >> (i & 63)) & 1u);
+}
+
+static inline void bitsetSet(uint64_t* set, int i) {
+    set[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+static inline void bitsetClear(uint64_t* set, int i) {
+    set[i >> 6] &= ~((uint64_t)1 << (i & 63));
+}
+
+// Function to find the first set bit at or after position from, or -1.
+// Uses count-trailing-zeros so runs of empty columns cost one test per word.
+static inline int bitsetNext(const uint64_t* set, int numWords, int from) {
+    int w = from >> 6;
+    if (w >= numWords) {
+        return -1;
+    }
+    uint64_t word = set[w] & (~(uint64_t)0 << (from & 63));
+    while (word == 0) {
+        if (++w == numWords) {
+            return -1;
+        }
+        word = set[w];
+    }
+    return (w << 6) + __builtin_ctzll(word);
+}
+
+// Function to count set bits before position end
+static inline int bitsetRank(const uint64_t* set, int end) {
+    int count = 0;
+    int w = 0;
+    for (; w < (end >> 6); w++) {
+        count += __builtin_popcountll(set[w]);
+    }
+    if (end & 63) {
+        count += __builtin_popcountll(set[w] & (((uint64_t)1 << (end & 63)) - 1));
+    }
+    return count;
+}
+
+// Function to find the position of the set bit with the given rank
+// (0 for the first set bit), or -1 if the set has fewer bits
+static inline int bitsetSelect(const uint64_t* set, int numWords, int rank) {
+    for (int w = 0; w < numWords; w++) {
+        int count = __builtin_popcountll(set[w]);
+        if (rank < count) {
+            uint64_t word = set[w];
+            for (; rank > 0; rank--) {
+                word &= word - 1;  // Drop the lowest set bit
+            }
+            return (w << 6) + __builtin_ctzll(word);
+        }
+        rank -= count;
+    }
+    return -1;
+}
+
+// Function to allocate an empty size x size matrix, returns 0 or -1 on failure
+static inline int bmCreate(BitMatrix* matrix, int size) {
+    matrix->size = size;
+    matrix->wordsPerRow = bitWords(size);
+    matrix->bits = (uint64_t*)calloc((size_t)size * matrix->wordsPerRow + 1, sizeof(uint64_t));
+    return matrix->bits ? 0 : -1;
+}
+
+static inline void bmFree(BitMatrix* matrix) {
+    free(matrix->bits);
+    matrix->bits = NULL;
+    matrix->size = 0;
+    matrix->wordsPerRow = 0;
+}
+
+static inline uint64_t* bmRow(const BitMatrix* matrix, int row) {
+    return matrix->bits + (size_t)row * matrix->wordsPerRow;
+}
+
+static inline int bmTest(const BitMatrix* matrix, int row, int col) {
+    return bitsetTest(bmRow(matrix, row), col);
+}
+
+static inline void bmSet(BitMatrix* matrix, int row, int col) {
+    bitsetSet(bmRow(matrix, row), col);
+}
+
+static inline void bmClear(BitMatrix* matrix, int row, int col) {
+    bitsetClear(bmRow(matrix, row), col);
+}
+
+// Function to find the next neighbor of row at or after column from, or -1
+static inline int bmNextInRow(const BitMatrix* matrix, int row, int from) {
+    return bitsetNext(bmRow(matrix, row), matrix->wordsPerRow, from);
+}
+
+// Function to count the edges in one row with popcount
+static inline int bmRowCount(const BitMatrix* matrix, int row) {
+    const uint64_t* bits = bmRow(matrix, row);
+    int count = 0;
+    for (int w = 0; w < matrix->wordsPerRow; w++) {
+        count += __builtin_popcountll(bits[w]);
+    }
+    return count;
+}
+
+// Function to add every column sum into counts (the in-degrees).
+// Only set bits are visited: each word is peeled with ctz and cleared
+// lowest-bit-first, so the cost is one load per word plus one step per edge.
+static inline void bmColumnCounts(const BitMatrix* matrix, int* counts) {
+    for (int row = 0; row < matrix->size; row++) {
+        const uint64_t* bits = bmRow(matrix, row);
+        for (int w = 0; w < matrix->wordsPerRow; w++) {
+            uint64_t word = bits[w];
+            while (word) {
+                counts[(w << 6) + __builtin_ctzll(word)]++;
+                word &= word - 1;
+            }
+        }
+    }
+}
+
+#endif // BIT_MATRIX_H
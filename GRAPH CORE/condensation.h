@@ -0,0 +1,275 @@
+#ifndef CONDENSATION_H
+#define CONDENSATION_H
+
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "dfs_cycle.h"
+#include "kahn.h"
+
+// Function to build the condensation of a graph: one vertex per SCC and one
+// edge per pair of distinct components joined by at least one graph edge.
+// Returns 0 on success, -1 if allocation fails.
+static inline int csrCondense(const CsrGraph* graph, const int* sccId, int components, CsrGraph* dag) {
+    int* srcList = (int*)malloc(((size_t)graph->numEdges + 1) * sizeof(int));
+    int* destList = (int*)malloc(((size_t)graph->numEdges + 1) * sizeof(int));
+    int* lastSource = (int*)malloc(((size_t)components + 1) * sizeof(int));
+    int* memberStart = (int*)calloc((size_t)components + 2, sizeof(int));
+    int* members = (int*)malloc(((size_t)graph->numVertices + 1) * sizeof(int));
+    int result = -1;
+    if (!srcList || !destList || !lastSource || !memberStart || !members) {
+        goto cleanup;
+    }
+
+    // Walk the members of one component at a time, so lastSource can drop
+    // repeated edges to the same target component
+    for (int v = 0; v < graph->numVertices; v++) {
+        memberStart[sccId[v] + 2]++;
+    }
+    for (int c = 0; c < components; c++) {
+        memberStart[c + 2] += memberStart[c + 1];
+        lastSource[c] = -1;
+    }
+    for (int v = 0; v < graph->numVertices; v++) {
+        members[memberStart[sccId[v] + 1]++] = v;
+    }
+
+    int edgeCount = 0;
+    for (int c = 0; c < components; c++) {
+        for (int i = memberStart[c]; i < memberStart[c + 1]; i++) {
+            int u = members[i];
+            for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+                int d = sccId[graph->targets[e]];
+                if (d != c && lastSource[d] != c) {
+                    lastSource[d] = c;
+                    srcList[edgeCount] = c;
+                    destList[edgeCount] = d;
+                    edgeCount++;
+                }
+            }
+        }
+    }
+    result = csrBuild(dag, components, edgeCount, srcList, destList, NULL);
+
+cleanup:
+    free(srcList);
+    free(destList);
+    free(lastSource);
+    free(memberStart);
+    free(members);
+    return result;
+}
+
+// Reachability index over a condensation DAG. Most queries are settled by
+// labels alone:
+//  - topoRank: a can only reach b if a comes first in a topological order
+//  - level: longest path to a sink, which strictly drops along every edge
+//  - GRAIL intervals: for each of numLabels randomized DFS traversals,
+//    [low, post] where post is the postorder rank and low the smallest rank
+//    below the vertex. If a reaches b, b's interval lies inside a's.
+// When every label allows it, a pruned DFS gives the exact answer.
+// Queries reuse the scratch arrays, so one index serves one thread at a time.
+typedef struct {
+    CsrGraph dag;
+    int numComponents;
+    int numLabels;
+    int* topoRank;
+    int* level;
+    int* low;           // numLabels * numComponents, label j of c at j * numComponents + c
+    int* post;
+    int* stamp;         // Fallback search: visited when equal to currentStamp
+    int currentStamp;
+    int* stack;
+    long long answeredByLabels;
+    long long fallbacks;
+} ReachIndex;
+
+static inline void reachIndexFree(ReachIndex* index) {
+    csrFree(&index->dag);
+    free(index->topoRank);
+    free(index->level);
+    free(index->low);
+    free(index->post);
+    free(index->stamp);
+    free(index->stack);
+    index->topoRank = index->level = index->low = index->post = NULL;
+    index->stamp = index->stack = NULL;
+}
+
+// Function to pick where a traversal starts scanning the children of c,
+// which varies the child order between labels without storing permutations
+static inline int reachRotation(unsigned seed, int label, int c, int degree) {
+    unsigned h = seed ^ (unsigned)(label + 1) * 0x9E3779B9u ^ (unsigned)c * 0x85EBCA6Bu;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    return (int)(h % (unsigned)degree);
+}
+
+// Function to assign one set of GRAIL intervals with an iterative DFS
+static inline void reachLabel(ReachIndex* index, int label, unsigned seed, DfsFrame* frames) {
+    const CsrGraph* dag = &index->dag;
+    int n = index->numComponents;
+    int* low = index->low + (size_t)label * n;
+    int* post = index->post + (size_t)label * n;
+    int rank = 0;
+
+    for (int c = 0; c < n; c++) {
+        post[c] = 0;
+    }
+
+    // Roots are tried in a rotated order, reversed on odd labels
+    int offset = n > 0 ? reachRotation(seed, label, -1, n) : 0;
+    for (int i = 0; i < n; i++) {
+        int root = (label & 1) ? (offset - i + n) % n : (offset + i) % n;
+        if (post[root] != 0) {
+            continue;
+        }
+
+        int top = 0;
+        frames[0].vertex = root;
+        frames[0].cursor = 0;
+        post[root] = -1;  // On the stack
+        low[root] = n + 1;
+
+        while (top >= 0) {
+            DfsFrame* frame = &frames[top];
+            int c = frame->vertex;
+            int degree = dag->offsets[c + 1] - dag->offsets[c];
+
+            if (frame->cursor < degree) {
+                int start = reachRotation(seed, label, c, degree);
+                int d = dag->targets[dag->offsets[c] + (start + frame->cursor++) % degree];
+                if (post[d] == 0) {
+                    post[d] = -1;
+                    low[d] = n + 1;
+                    top++;
+                    frames[top].vertex = d;
+                    frames[top].cursor = 0;
+                } else if (low[d] < low[c]) {
+                    low[c] = low[d];
+                }
+                continue;
+            }
+
+            post[c] = ++rank;
+            if (rank < low[c]) {
+                low[c] = rank;
+            }
+            top--;
+            if (top >= 0 && low[c] < low[frames[top].vertex]) {
+                low[frames[top].vertex] = low[c];
+            }
+        }
+    }
+}
+
+// Function to build the condensation of graph and its reachability index.
+// sccId and components describe any SCC labelling of graph. numLabels is
+// the number of GRAIL traversals, seed varies their child orders.
+// Returns 0 on success, -1 if allocation fails.
+static inline int reachIndexBuild(ReachIndex* index, const CsrGraph* graph, const int* sccId, int components,
+                                  int numLabels, unsigned seed) {
+    int n = components;
+    size_t labelled = (size_t)numLabels * n + 1;
+    index->numComponents = n;
+    index->numLabels = numLabels;
+    index->currentStamp = 0;
+    index->answeredByLabels = index->fallbacks = 0;
+    index->topoRank = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    index->level = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    index->low = (int*)malloc(labelled * sizeof(int));
+    index->post = (int*)malloc(labelled * sizeof(int));
+    index->stamp = (int*)calloc((size_t)n + 1, sizeof(int));
+    index->stack = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* order = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    DfsFrame* frames = (DfsFrame*)malloc(((size_t)n + 1) * sizeof(DfsFrame));
+    index->dag = (CsrGraph){0};
+
+    if (!index->topoRank || !index->level || !index->low || !index->post || !index->stamp ||
+        !index->stack || !order || !frames || csrCondense(graph, sccId, components, &index->dag) != 0 ||
+        csrKahnOrder(&index->dag, order) != n) {
+        free(order);
+        free(frames);
+        reachIndexFree(index);
+        return -1;
+    }
+
+    // Levels are filled sinks first, walking the topological order backwards
+    for (int i = 0; i < n; i++) {
+        index->topoRank[order[i]] = i;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        int c = order[i];
+        index->level[c] = 0;
+        for (int e = index->dag.offsets[c]; e < index->dag.offsets[c + 1]; e++) {
+            int d = index->dag.targets[e];
+            if (index->level[d] + 1 > index->level[c]) {
+                index->level[c] = index->level[d] + 1;
+            }
+        }
+    }
+
+    for (int label = 0; label < numLabels; label++) {
+        reachLabel(index, label, seed, frames);
+    }
+
+    free(order);
+    free(frames);
+    return 0;
+}
+
+// Function to test the labels: 0 if they prove a cannot reach b, 1 otherwise
+static inline int reachLabelsAllow(const ReachIndex* index, int a, int b) {
+    if (index->topoRank[a] >= index->topoRank[b] || index->level[a] <= index->level[b]) {
+        return 0;
+    }
+    int n = index->numComponents;
+    for (int label = 0; label < index->numLabels; label++) {
+        size_t base = (size_t)label * n;
+        if (index->low[base + b] < index->low[base + a] || index->post[base + b] > index->post[base + a]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Function to check whether component a reaches component b in the DAG.
+// Every component reaches itself. Returns 1 or 0.
+static inline int reachIndexQuery(ReachIndex* index, int a, int b) {
+    if (a == b) {
+        return 1;
+    }
+    if (!reachLabelsAllow(index, a, b)) {
+        index->answeredByLabels++;
+        return 0;
+    }
+
+    // Fallback: DFS from a, entering only components the labels still allow
+    index->fallbacks++;
+    if (++index->currentStamp == 0) {
+        for (int c = 0; c < index->numComponents; c++) {
+            index->stamp[c] = 0;
+        }
+        index->currentStamp = 1;
+    }
+    int top = 0;
+    index->stack[top++] = a;
+    index->stamp[a] = index->currentStamp;
+    while (top > 0) {
+        int c = index->stack[--top];
+        for (int e = index->dag.offsets[c]; e < index->dag.offsets[c + 1]; e++) {
+            int d = index->dag.targets[e];
+            if (d == b) {
+                return 1;
+            }
+            if (index->stamp[d] != index->currentStamp && reachLabelsAllow(index, d, b)) {
+                index->stamp[d] = index->currentStamp;
+                index->stack[top++] = d;
+            }
+        }
+    }
+    return 0;
+}
+
+#endif // CONDENSATION_H
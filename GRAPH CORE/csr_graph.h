@@ -0,0 +1,116 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <stdlib.h>
+
+// Compressed sparse row graph shared by the adjacency-list programs.
+// The out-edges of vertex v are targets[offsets[v]] .. targets[offsets[v + 1] - 1],
+// so walking a neighbor list is a linear scan over one contiguous array.
+typedef struct {
+    int numVertices;
+    int numEdges;
+    int* offsets;   // numVertices + 1 entries
+    int* targets;   // numEdges entries
+    int* weights;   // numEdges entries, NULL for unweighted graphs
+} CsrGraph;
+
+// Function to release the arrays owned by a CSR graph
+static inline void csrFree(CsrGraph* graph) {
+    free(graph->offsets);
+    free(graph->targets);
+    free(graph->weights);
+    graph->offsets = NULL;
+    graph->targets = NULL;
+    graph->weights = NULL;
+    graph->numVertices = 0;
+    graph->numEdges = 0;
+}
+
+// Function to build a CSR graph from an edge stream in two passes:
+// the first pass counts out-degrees, the second scatters the targets.
+// Each row is filled from its end so neighbors come out newest first,
+// the same order the old head-inserted linked lists produced.
+// weights may be NULL. Returns 0 on success, -1 if allocation fails.
+static inline int csrBuild(CsrGraph* graph, int numVertices, int numEdges,
+                           const int* src, const int* dest, const int* weights) {
+    graph->numVertices = numVertices;
+    graph->numEdges = numEdges;
+    graph->offsets = (int*)calloc((size_t)numVertices + 1, sizeof(int));
+    graph->targets = (int*)malloc(((size_t)numEdges + 1) * sizeof(int));
+    graph->weights = weights ? (int*)malloc(((size_t)numEdges + 1) * sizeof(int)) : NULL;
+    if (!graph->offsets || !graph->targets || (weights && !graph->weights)) {
+        csrFree(graph);
+        return -1;
+    }
+
+    // Pass 1: out-degree of every vertex, then prefix sums into row offsets
+    for (int i = 0; i < numEdges; i++) {
+        graph->offsets[src[i] + 1]++;
+    }
+    for (int v = 0; v < numVertices; v++) {
+        graph->offsets[v + 1] += graph->offsets[v];
+    }
+
+    // Pass 2: scatter each edge into its row, using a cursor per row
+    int* cursor = (int*)malloc(((size_t)numVertices + 1) * sizeof(int));
+    if (!cursor) {
+        csrFree(graph);
+        return -1;
+    }
+    for (int v = 0; v < numVertices; v++) {
+        cursor[v] = graph->offsets[v + 1];
+    }
+    for (int i = 0; i < numEdges; i++) {
+        int slot = --cursor[src[i]];
+        graph->targets[slot] = dest[i];
+        if (weights) {
+            graph->weights[slot] = weights[i];
+        }
+    }
+    free(cursor);
+
+    return 0;
+}
+
+// Function to find the first edge u -> v, returns its index or -1
+static inline int csrFindEdge(const CsrGraph* graph, int u, int v) {
+    for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+        if (graph->targets[e] == v) {
+            return e;
+        }
+    }
+    return -1;
+}
+
+// Function to find the source vertex of edge e by binary search over the row offsets
+static inline int csrEdgeSource(const CsrGraph* graph, int e) {
+    int lo = 0, hi = graph->numVertices - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (graph->offsets[mid] <= e) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+// Function to build the transpose (every edge reversed) of a CSR graph.
+// Weights are carried along. Returns 0 on success, -1 if allocation fails.
+static inline int csrTranspose(const CsrGraph* graph, CsrGraph* reverse) {
+    int* src = (int*)calloc((size_t)graph->numEdges + 1, sizeof(int));
+    if (!src) {
+        return -1;
+    }
+    for (int v = 0; v < graph->numVertices; v++) {
+        for (int e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+            src[e] = v;
+        }
+    }
+    int result = csrBuild(reverse, graph->numVertices, graph->numEdges, graph->targets, src, graph->weights);
+    free(src);
+    return result;
+}
+
+#endif // CSR_GRAPH_H
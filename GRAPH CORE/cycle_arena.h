@@ -0,0 +1,86 @@
+#ifndef CYCLE_ARENA_H
+#define CYCLE_ARENA_H
+
+#include <stdlib.h>
+
+// Append-only store for detected cycles. Every cycle is a run of edge
+// indices packed back to back in items; cycle i occupies
+// items[offsets[i]] .. items[offsets[i + 1] - 1]. Both arrays double when
+// full, so memory stays proportional to the cycles actually found.
+typedef struct {
+    int* items;
+    size_t used;
+    size_t capacity;
+    size_t* offsets;   // count + 1 entries; offsets[count] starts the open cycle
+    int count;
+    int offsetCapacity;
+} CycleArena;
+
+static inline void cycleArenaFree(CycleArena* arena) {
+    free(arena->items);
+    free(arena->offsets);
+    arena->items = NULL;
+    arena->offsets = NULL;
+    arena->used = arena->capacity = 0;
+    arena->count = arena->offsetCapacity = 0;
+}
+
+// Function to create an empty arena. Returns 0 on success, -1 if allocation fails.
+static inline int cycleArenaInit(CycleArena* arena) {
+    arena->capacity = 64;
+    arena->offsetCapacity = 16;
+    arena->used = 0;
+    arena->count = 0;
+    arena->items = (int*)malloc(arena->capacity * sizeof(int));
+    arena->offsets = (size_t*)malloc(arena->offsetCapacity * sizeof(size_t));
+    if (!arena->items || !arena->offsets) {
+        cycleArenaFree(arena);
+        return -1;
+    }
+    arena->offsets[0] = 0;
+    return 0;
+}
+
+// Function to forget every recorded cycle while keeping the storage
+static inline void cycleArenaReset(CycleArena* arena) {
+    arena->used = 0;
+    arena->count = 0;
+}
+
+// Function to append one edge index to the cycle being recorded. Returns 0 or -1.
+static inline int cycleArenaPush(CycleArena* arena, int item) {
+    if (arena->used == arena->capacity) {
+        size_t capacity = 2 * arena->capacity;
+        int* items = (int*)realloc(arena->items, capacity * sizeof(int));
+        if (!items) {
+            return -1;
+        }
+        arena->items = items;
+        arena->capacity = capacity;
+    }
+    arena->items[arena->used++] = item;
+    return 0;
+}
+
+// Function to seal the cycle being recorded and start a new one. Returns 0 or -1.
+static inline int cycleArenaClose(CycleArena* arena) {
+    if (arena->count + 1 == arena->offsetCapacity) {
+        int capacity = 2 * arena->offsetCapacity;
+        size_t* offsets = (size_t*)realloc(arena->offsets, capacity * sizeof(size_t));
+        if (!offsets) {
+            return -1;
+        }
+        arena->offsets = offsets;
+        arena->offsetCapacity = capacity;
+    }
+    arena->offsets[++arena->count] = arena->used;
+    return 0;
+}
+
+// Function to get cycle i as a pointer into the arena and its length
+static inline const int* cycleArenaGet(const CycleArena* arena, int i, int* length) {
+    *length = (int)(arena->offsets[i + 1] - arena->offsets[i]);
+    return arena->items + arena->offsets[i];
+}
+
+#endif // CYCLE_ARENA_H
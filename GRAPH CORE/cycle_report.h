@@ -0,0 +1,68 @@
+#ifndef CYCLE_REPORT_H
+#define CYCLE_REPORT_H
+
+#include <stdio.h>
+
+#include "csr_graph.h"
+#include "dfs_cycle.h"
+#include "intern_table.h"
+#include "wait_for.h"
+
+// Function to print a cycle as "Cycle detected: a -> b -> a"
+static inline void cycleReportPrint(const InternTable* labels, const int* cycle, int length) {
+    printf("Cycle detected: ");
+    for (int j = 0; j < length; j++) {
+        printf("%s -> ", internName(labels, cycle[j]));
+    }
+    printf("%s\n", internName(labels, cycle[0]));
+}
+
+// Function to find a cycle with the iterative DFS from vertex, so that long
+// wait chains use the preallocated frame stack instead of native recursion.
+// On a wait-for projection (wfg not NULL) the cycle is mapped back to the
+// original ids through expanded, which needs room for twice as many vertices.
+// Points *found at the cycle and returns its length, or 0 if there is none.
+static inline int cycleFindFrom(const CsrGraph* graph, int vertex, unsigned char* state, DfsFrame* frames,
+                                int* cycle, const WaitForGraph* wfg, int* expanded, int** found) {
+    int cycleLength = csrFindCycleFrom(graph, vertex, state, frames, cycle);
+    *found = cycle;
+    if (cycleLength > 0 && wfg) {
+        cycleLength = waitForExpandCycle(wfg, cycle, cycleLength, expanded);
+        *found = expanded;
+    }
+    return cycleLength;
+}
+
+// Function to rotate a cycle in place so that it starts at its smallest id
+static inline void cycleRotateToMin(int* cycle, int length) {
+    int first = 0;
+    for (int i = 1; i < length; i++) {
+        if (cycle[i] < cycle[first]) {
+            first = i;
+        }
+    }
+    // Three reversals rotate without a second buffer
+    for (int pass = 0; pass < 3; pass++) {
+        int lo = pass == 1 ? first : 0, hi = pass == 0 ? first - 1 : length - 1;
+        for (; lo < hi; lo++, hi--) {
+            int swap = cycle[lo];
+            cycle[lo] = cycle[hi];
+            cycle[hi] = swap;
+        }
+    }
+}
+
+// Cycle detection and printing function built on cycleFindFrom.
+// Returns 1 if a cycle was found and printed, 0 otherwise.
+static inline int cycleReportFrom(const CsrGraph* graph, int vertex, unsigned char* state, const InternTable* labels,
+                                  DfsFrame* frames, int* cycle, const WaitForGraph* wfg, int* expanded) {
+    int* found;
+    int cycleLength = cycleFindFrom(graph, vertex, state, frames, cycle, wfg, expanded, &found);
+    if (cycleLength == 0) {
+        return 0;
+    }
+    cycleReportPrint(labels, found, cycleLength);
+    return 1;
+}
+
+#endif // CYCLE_REPORT_H
@@ -0,0 +1,62 @@
+#ifndef DFS_CYCLE_H
+#define DFS_CYCLE_H
+
+#include "csr_graph.h"
+
+// Vertex states for the iterative DFS
+#define DFS_UNVISITED 0
+#define DFS_ON_STACK  1
+#define DFS_DONE      2
+
+// One explicit stack frame: the vertex and the next CSR edge to examine.
+// A vertex is on the stack at most once, so numVertices frames always suffice.
+typedef struct {
+    int vertex;
+    int cursor;
+} DfsFrame;
+
+// Function to run an iterative DFS from root looking for a cycle.
+// state holds one DFS_* value per vertex and is shared across roots;
+// frames must have room for numVertices entries.
+// On success the cycle vertices are written to cycle (the closing vertex
+// is not repeated) and the cycle length is returned, otherwise 0.
+static inline int csrFindCycleFrom(const CsrGraph* graph, int root, unsigned char* state,
+                                   DfsFrame* frames, int* cycle) {
+    int top = 0;
+    frames[0].vertex = root;
+    frames[0].cursor = graph->offsets[root];
+    state[root] = DFS_ON_STACK;
+
+    while (top >= 0) {
+        DfsFrame* frame = &frames[top];
+
+        if (frame->cursor == graph->offsets[frame->vertex + 1]) {
+            // All neighbors explored, retreat
+            state[frame->vertex] = DFS_DONE;
+            top--;
+            continue;
+        }
+
+        int adjVertex = graph->targets[frame->cursor++];
+        if (state[adjVertex] == DFS_UNVISITED) {
+            state[adjVertex] = DFS_ON_STACK;
+            top++;
+            frames[top].vertex = adjVertex;
+            frames[top].cursor = graph->offsets[adjVertex];
+        } else if (state[adjVertex] == DFS_ON_STACK) {
+            // Back edge: the cycle is the stack segment starting at adjVertex
+            int start = top;
+            while (frames[start].vertex != adjVertex) {
+                start--;
+            }
+            for (int i = start; i <= top; i++) {
+                cycle[i - start] = frames[i].vertex;
+            }
+            return top - start + 1;
+        }
+    }
+
+    return 0;
+}
+
+#endif // DFS_CYCLE_H
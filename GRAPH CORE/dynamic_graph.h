@@ -0,0 +1,429 @@
+#ifndef DYNAMIC_GRAPH_H
+#define DYNAMIC_GRAPH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "int_vector.h"
+
+// Fully dynamic request/assignment graph.
+// Each vertex keeps its outgoing edge ids in an IntVector; an edge remembers
+// its slot there, so deleting it is a swap with the last slot. A hash table
+// keyed by (from, to) finds the edge id, giving O(1) amortized insert/delete.
+//
+// Detection state is kept lazily. Vertices sit in an order node[0..n-1] in
+// which every strongly connected component is a contiguous run and every
+// edge between components points forward (pos[from] < pos[to]). An update
+// that may break this only records the run of positions it affects:
+//  - insert u -> v pointing backward: the runs from v's component to u's,
+//  - delete u -> v inside a component, or toggle a self-loop: that component.
+// dgRefresh recomputes SCCs inside each recorded run and reorders just that
+// run, so untouched components are never rechecked.
+typedef struct {
+    int from;
+    int to;
+    int slot;  // Index of this edge in out[from]
+} DynEdge;
+
+typedef struct {
+    int lo;
+    int hi;
+} DynRange;
+
+typedef struct {
+    int numVertices;
+    IntVector* out;       // Edge ids leaving each vertex
+    DynEdge* edges;       // Edge pool, freed ids chained through .from
+    int edgeCapacity;
+    int edgeUsed;
+    int freeEdge;
+    int numEdges;
+    int* table;           // Edge id + 1 per slot, 0 for empty
+    uint32_t tableMask;
+
+    int* pos;             // Position of each vertex in the component order
+    int* node;            // Vertex at each position
+    int* sccId;           // Component id, valid once refreshed
+    int* runStart;        // First and last position of each vertex's component run,
+    int* runEnd;          // stored when the run is laid out
+    int nextSccId;
+    int cyclicCount;      // Components with a cycle (size > 1 or a self-loop)
+    unsigned char* cyclicLeader;  // First vertex of a cyclic component's run
+    DynRange* dirty;      // Runs waiting for dgRefresh
+    int dirtyCount;
+    int dirtyCapacity;
+
+    // Tarjan scratch space, reused by every refresh
+    int* index;
+    int* low;
+    int* stamp;           // Refresh epoch in which index/low are valid
+    int epoch;
+    int* stack;
+    unsigned char* onStack;
+    int* frameVertex;
+    int* frameCursor;
+    int* emitted;         // Vertices in component completion order
+    int* compEnd;         // End offset in emitted of each component
+} DynamicGraph;
+
+static inline uint32_t dgHash(int from, int to) {
+    uint64_t key = ((uint64_t)(uint32_t)from << 32) | (uint32_t)to;
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (uint32_t)key;
+}
+
+static inline void dgFree(DynamicGraph* g) {
+    if (g->out) {
+        for (int v = 0; v < g->numVertices; v++) {
+            free(g->out[v].items);
+        }
+    }
+    free(g->out);
+    free(g->edges);
+    free(g->table);
+    free(g->pos);
+    free(g->node);
+    free(g->sccId);
+    free(g->runStart);
+    free(g->runEnd);
+    free(g->cyclicLeader);
+    free(g->dirty);
+    free(g->index);
+    free(g->low);
+    free(g->stamp);
+    free(g->stack);
+    free(g->onStack);
+    free(g->frameVertex);
+    free(g->frameCursor);
+    free(g->emitted);
+    free(g->compEnd);
+}
+
+// Function to create an edgeless graph on n vertices. Returns 0 or -1.
+static inline int dgInit(DynamicGraph* g, int numVertices) {
+    size_t n = (size_t)numVertices + 1;
+    g->numVertices = numVertices;
+    g->edges = NULL;
+    g->edgeCapacity = g->edgeUsed = g->numEdges = 0;
+    g->freeEdge = -1;
+    g->tableMask = 15;
+    g->nextSccId = numVertices;
+    g->cyclicCount = 0;
+    g->dirty = NULL;
+    g->dirtyCount = g->dirtyCapacity = 0;
+    g->epoch = 0;
+    g->out = (IntVector*)calloc(n, sizeof(IntVector));
+    g->table = (int*)calloc(g->tableMask + 1, sizeof(int));
+    g->pos = (int*)malloc(n * sizeof(int));
+    g->node = (int*)malloc(n * sizeof(int));
+    g->sccId = (int*)malloc(n * sizeof(int));
+    g->runStart = (int*)malloc(n * sizeof(int));
+    g->runEnd = (int*)malloc(n * sizeof(int));
+    g->cyclicLeader = (unsigned char*)calloc(n, 1);
+    g->index = (int*)malloc(n * sizeof(int));
+    g->low = (int*)malloc(n * sizeof(int));
+    g->stamp = (int*)calloc(n, sizeof(int));
+    g->stack = (int*)malloc(n * sizeof(int));
+    g->onStack = (unsigned char*)calloc(n, 1);
+    g->frameVertex = (int*)malloc(n * sizeof(int));
+    g->frameCursor = (int*)malloc(n * sizeof(int));
+    g->emitted = (int*)malloc(n * sizeof(int));
+    g->compEnd = (int*)malloc(n * sizeof(int));
+    if (!g->out || !g->table || !g->pos || !g->node || !g->sccId || !g->runStart || !g->runEnd ||
+        !g->cyclicLeader || !g->index || !g->low || !g->stamp || !g->stack || !g->onStack ||
+        !g->frameVertex || !g->frameCursor || !g->emitted || !g->compEnd) {
+        dgFree(g);
+        return -1;
+    }
+    for (int v = 0; v < numVertices; v++) {
+        g->pos[v] = v;
+        g->node[v] = v;
+        g->sccId[v] = v;
+        g->runStart[v] = g->runEnd[v] = v;
+    }
+    return 0;
+}
+
+// Function to find the table slot holding (from, to), or the empty slot where it belongs
+static inline uint32_t dgProbe(const DynamicGraph* g, int from, int to) {
+    uint32_t slot = dgHash(from, to) & g->tableMask;
+    while (g->table[slot] != 0) {
+        const DynEdge* edge = &g->edges[g->table[slot] - 1];
+        if (edge->from == from && edge->to == to) {
+            break;
+        }
+        slot = (slot + 1) & g->tableMask;
+    }
+    return slot;
+}
+
+// Function to return the id of edge from -> to, or -1 if absent
+static inline int dgFindEdge(const DynamicGraph* g, int from, int to) {
+    return g->table[dgProbe(g, from, to)] - 1;
+}
+
+// Function to double the hash table. Returns 0 or -1.
+static inline int dgGrowTable(DynamicGraph* g) {
+    uint32_t capacity = 2 * (g->tableMask + 1);
+    int* old = g->table;
+    uint32_t oldCapacity = g->tableMask + 1;
+    g->table = (int*)calloc(capacity, sizeof(int));
+    if (!g->table) {
+        g->table = old;
+        return -1;
+    }
+    g->tableMask = capacity - 1;
+    for (uint32_t i = 0; i < oldCapacity; i++) {
+        if (old[i] != 0) {
+            const DynEdge* edge = &g->edges[old[i] - 1];
+            g->table[dgProbe(g, edge->from, edge->to)] = old[i];
+        }
+    }
+    free(old);
+    return 0;
+}
+
+// Function to record that positions lo..hi need their components recomputed
+static inline int dgMarkDirty(DynamicGraph* g, int lo, int hi) {
+    if (g->dirtyCount == g->dirtyCapacity) {
+        int capacity = g->dirtyCapacity ? 2 * g->dirtyCapacity : 8;
+        DynRange* dirty = (DynRange*)realloc(g->dirty, capacity * sizeof(DynRange));
+        if (!dirty) {
+            return -1;
+        }
+        g->dirty = dirty;
+        g->dirtyCapacity = capacity;
+    }
+    g->dirty[g->dirtyCount].lo = lo;
+    g->dirty[g->dirtyCount].hi = hi;
+    g->dirtyCount++;
+    return 0;
+}
+
+// Function to find the first position of the component run containing p
+static inline int dgRunStart(const DynamicGraph* g, int p) {
+    return g->runStart[g->node[p]];
+}
+
+// Function to find the last position of the component run containing p
+static inline int dgRunEnd(const DynamicGraph* g, int p) {
+    return g->runEnd[g->node[p]];
+}
+
+// Function to insert edge from -> to.
+// Returns 1 if inserted, 0 if it already existed, -1 if allocation fails.
+static inline int dgInsertEdge(DynamicGraph* g, int from, int to) {
+    if (dgFindEdge(g, from, to) != -1) {
+        return 0;
+    }
+    if (2 * (uint32_t)(g->numEdges + 1) > g->tableMask + 1 && dgGrowTable(g) != 0) {
+        return -1;
+    }
+
+    int id = g->freeEdge;
+    if (id != -1) {
+        g->freeEdge = g->edges[id].from;
+    } else {
+        if (g->edgeUsed == g->edgeCapacity) {
+            int capacity = g->edgeCapacity ? 2 * g->edgeCapacity : 16;
+            DynEdge* edges = (DynEdge*)realloc(g->edges, capacity * sizeof(DynEdge));
+            if (!edges) {
+                return -1;
+            }
+            g->edges = edges;
+            g->edgeCapacity = capacity;
+        }
+        id = g->edgeUsed++;
+    }
+    if (intVectorPush(&g->out[from], id) != 0) {
+        g->edges[id].from = g->freeEdge;
+        g->freeEdge = id;
+        return -1;
+    }
+    g->edges[id].from = from;
+    g->edges[id].to = to;
+    g->edges[id].slot = g->out[from].size - 1;
+    g->table[dgProbe(g, from, to)] = id + 1;
+    g->numEdges++;
+
+    // Invalidate only what the edge can change
+    int pu = g->pos[from], pv = g->pos[to];
+    if (from == to) {
+        return dgMarkDirty(g, dgRunStart(g, pu), dgRunEnd(g, pu)) == 0 ? 1 : -1;
+    }
+    if (g->sccId[from] == g->sccId[to] || pu < pv) {
+        return 1;  // Inside one component, or consistent with the order
+    }
+    return dgMarkDirty(g, dgRunStart(g, pv), dgRunEnd(g, pu)) == 0 ? 1 : -1;
+}
+
+// Function to delete edge from -> to.
+// Returns 1 if deleted, 0 if absent, -1 if allocation fails.
+static inline int dgDeleteEdge(DynamicGraph* g, int from, int to) {
+    uint32_t slot = dgProbe(g, from, to);
+    int id = g->table[slot] - 1;
+    if (id == -1) {
+        return 0;
+    }
+
+    // Swap-remove from the source's edge vector
+    IntVector* out = &g->out[from];
+    int last = out->items[--out->size];
+    out->items[g->edges[id].slot] = last;
+    g->edges[last].slot = g->edges[id].slot;
+
+    // Backward-shift deletion keeps linear probing free of tombstones
+    uint32_t hole = slot;
+    uint32_t next = (hole + 1) & g->tableMask;
+    while (g->table[next] != 0) {
+        const DynEdge* edge = &g->edges[g->table[next] - 1];
+        uint32_t home = dgHash(edge->from, edge->to) & g->tableMask;
+        if (((next - home) & g->tableMask) >= ((next - hole) & g->tableMask)) {
+            g->table[hole] = g->table[next];
+            hole = next;
+        }
+        next = (next + 1) & g->tableMask;
+    }
+    g->table[hole] = 0;
+
+    g->edges[id].from = g->freeEdge;
+    g->freeEdge = id;
+    g->numEdges--;
+
+    // Only an edge inside a component can split it
+    if (g->sccId[from] != g->sccId[to]) {
+        return 1;
+    }
+    int p = g->pos[from];
+    return dgMarkDirty(g, dgRunStart(g, p), dgRunEnd(g, p)) == 0 ? 1 : -1;
+}
+
+static inline int dgCompareRanges(const void* a, const void* b) {
+    int x = ((const DynRange*)a)->lo, y = ((const DynRange*)b)->lo;
+    return (x > y) - (x < y);
+}
+
+// Function to recompute components of the vertices at positions lo..hi.
+// Edges leaving the run are ignored: they point forward, so no cycle can
+// leave the run and come back.
+static inline void dgRefreshRange(DynamicGraph* g, int lo, int hi) {
+    int epoch = ++g->epoch;
+
+    for (int p = lo; p <= hi; p++) {
+        int v = g->node[p];
+        if (g->cyclicLeader[v]) {
+            g->cyclicLeader[v] = 0;
+            g->cyclicCount--;
+        }
+    }
+
+    // Iterative Tarjan restricted to the run
+    int counter = 0, top = 0, emittedCount = 0, components = 0;
+    for (int p = lo; p <= hi; p++) {
+        int root = g->node[p];
+        if (g->stamp[root] == epoch) {
+            continue;
+        }
+        int depth = 0;
+        g->stamp[root] = epoch;
+        g->index[root] = g->low[root] = counter++;
+        g->stack[top++] = root;
+        g->onStack[root] = 1;
+        g->frameVertex[depth] = root;
+        g->frameCursor[depth++] = 0;
+
+        while (depth > 0) {
+            int v = g->frameVertex[depth - 1];
+            IntVector* out = &g->out[v];
+            if (g->frameCursor[depth - 1] < out->size) {
+                int w = g->edges[out->items[g->frameCursor[depth - 1]++]].to;
+                if (g->pos[w] < lo || g->pos[w] > hi) {
+                    continue;
+                }
+                if (g->stamp[w] != epoch) {
+                    g->stamp[w] = epoch;
+                    g->index[w] = g->low[w] = counter++;
+                    g->stack[top++] = w;
+                    g->onStack[w] = 1;
+                    g->frameVertex[depth] = w;
+                    g->frameCursor[depth++] = 0;
+                } else if (g->onStack[w] && g->index[w] < g->low[v]) {
+                    g->low[v] = g->index[w];
+                }
+                continue;
+            }
+
+            depth--;
+            if (depth > 0) {
+                int parent = g->frameVertex[depth - 1];
+                if (g->low[v] < g->low[parent]) {
+                    g->low[parent] = g->low[v];
+                }
+            }
+            if (g->low[v] == g->index[v]) {
+                int w;
+                do {
+                    w = g->stack[--top];
+                    g->onStack[w] = 0;
+                    g->emitted[emittedCount++] = w;
+                } while (w != v);
+                g->compEnd[components++] = emittedCount;
+            }
+        }
+    }
+
+    // Components complete in reverse topological order; lay them out forward
+    int p = lo;
+    for (int c = components - 1; c >= 0; c--) {
+        int begin = c > 0 ? g->compEnd[c - 1] : 0;
+        int end = g->compEnd[c];
+        int id = g->nextSccId++;
+        int runStart = p, runEnd = p + (end - begin) - 1;
+        for (int k = begin; k < end; k++) {
+            int v = g->emitted[k];
+            g->sccId[v] = id;
+            g->runStart[v] = runStart;
+            g->runEnd[v] = runEnd;
+            g->pos[v] = p;
+            g->node[p++] = v;
+        }
+        int first = g->emitted[begin];
+        if (end - begin > 1 || dgFindEdge(g, first, first) != -1) {
+            g->cyclicLeader[g->node[runStart]] = 1;
+            g->cyclicCount++;
+        }
+    }
+}
+
+// Function to bring sccId and the component order up to date.
+// Returns the number of vertices that had to be rechecked.
+static inline int dgRefresh(DynamicGraph* g) {
+    if (g->dirtyCount == 0) {
+        return 0;
+    }
+    qsort(g->dirty, g->dirtyCount, sizeof(DynRange), dgCompareRanges);
+
+    // Overlapping runs are merged; a cycle never spans two disjoint runs
+    int rechecked = 0;
+    int lo = g->dirty[0].lo, hi = g->dirty[0].hi;
+    for (int i = 1; i <= g->dirtyCount; i++) {
+        if (i < g->dirtyCount && g->dirty[i].lo <= hi) {
+            if (g->dirty[i].hi > hi) {
+                hi = g->dirty[i].hi;
+            }
+            continue;
+        }
+        dgRefreshRange(g, lo, hi);
+        rechecked += hi - lo + 1;
+        if (i < g->dirtyCount) {
+            lo = g->dirty[i].lo;
+            hi = g->dirty[i].hi;
+        }
+    }
+    g->dirtyCount = 0;
+    return rechecked;
+}
+
+#endif // DYNAMIC_GRAPH_H
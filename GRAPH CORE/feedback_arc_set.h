@@ -0,0 +1,231 @@
+#ifndef FEEDBACK_ARC_SET_H
+#define FEEDBACK_ARC_SET_H
+
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "scc.h"
+
+// Max-heap entry keyed by a vertex's weighted out-minus-in degree.
+// Keys are never updated in place: a changed vertex is pushed again and
+// stale entries are skipped when popped.
+typedef struct {
+    long long key;
+    int vertex;
+} FasHeapEntry;
+
+static inline void fasHeapPush(FasHeapEntry* heap, int* size, long long key, int vertex) {
+    int i = (*size)++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (heap[parent].key >= key) {
+            break;
+        }
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i].key = key;
+    heap[i].vertex = vertex;
+}
+
+static inline FasHeapEntry fasHeapPop(FasHeapEntry* heap, int* size) {
+    FasHeapEntry top = heap[0];
+    FasHeapEntry last = heap[--(*size)];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= *size) {
+            break;
+        }
+        if (child + 1 < *size && heap[child + 1].key > heap[child].key) {
+            child++;
+        }
+        if (heap[child].key <= last.key) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (*size > 0) {
+        heap[i] = last;
+    }
+    return top;
+}
+
+// Working state of one feedback arc set computation
+typedef struct {
+    const CsrGraph* graph;
+    CsrGraph reverse;
+    const int* sccId;
+    int* inCount;             // Live intra-SCC in-edges
+    int* outCount;            // Live intra-SCC out-edges
+    long long* inWeight;
+    long long* outWeight;
+    unsigned char* placed;
+    int* sources;
+    int* sinks;
+    int sourceCount;
+    int sinkCount;
+    FasHeapEntry* heap;
+    int heapSize;
+} FasState;
+
+static inline int fasWeight(const CsrGraph* graph, int e) {
+    return graph->weights ? graph->weights[e] : 1;
+}
+
+// An edge takes part in the ordering if it joins two distinct vertices of one SCC
+static inline int fasCounts(const FasState* fas, int u, int v) {
+    return u != v && fas->sccId[u] == fas->sccId[v];
+}
+
+// Function to take vertex x out of the graph and update its live neighbors
+static inline void fasRemoveVertex(FasState* fas, int x) {
+    const CsrGraph* graph = fas->graph;
+    fas->placed[x] = 1;
+    for (int e = graph->offsets[x]; e < graph->offsets[x + 1]; e++) {
+        int y = graph->targets[e];
+        if (fas->placed[y] || !fasCounts(fas, x, y)) {
+            continue;
+        }
+        fas->inWeight[y] -= fasWeight(graph, e);
+        if (--fas->inCount[y] == 0) {
+            fas->sources[fas->sourceCount++] = y;
+        } else {
+            fasHeapPush(fas->heap, &fas->heapSize, fas->outWeight[y] - fas->inWeight[y], y);
+        }
+    }
+    for (int e = fas->reverse.offsets[x]; e < fas->reverse.offsets[x + 1]; e++) {
+        int p = fas->reverse.targets[e];
+        if (fas->placed[p] || !fasCounts(fas, p, x)) {
+            continue;
+        }
+        fas->outWeight[p] -= fasWeight(&fas->reverse, e);
+        if (--fas->outCount[p] == 0) {
+            fas->sinks[fas->sinkCount++] = p;
+        } else {
+            fasHeapPush(fas->heap, &fas->heapSize, fas->outWeight[p] - fas->inWeight[p], p);
+        }
+    }
+}
+
+// Weighted Eades-Lin-Smyth feedback arc set.
+// Every cycle lies inside one SCC, so only intra-SCC edges are ordered:
+// sinks are peeled to the back of a vertex sequence, sources to the front,
+// and otherwise the vertex with the largest outgoing-minus-incoming weight
+// goes to the front. Intra-SCC edges pointing backward in the sequence
+// (self-loops included) form the feedback arc set; dropping them leaves the
+// graph acyclic. Runs in O(E log V); edge weights are the removal costs,
+// or 1 each when the graph is unweighted.
+//
+// Sets removed[e] to 1 for every edge in the set and 0 otherwise.
+// Returns the total weight removed, or -1 if allocation fails.
+static inline long long csrFeedbackArcSet(const CsrGraph* graph, unsigned char* removed) {
+    int n = graph->numVertices;
+    size_t slots = (size_t)n + 1;
+    FasState fas;
+    fas.graph = graph;
+    int* sccId = (int*)malloc(slots * sizeof(int));
+    int* position = (int*)malloc(slots * sizeof(int));
+    fas.inCount = (int*)calloc(slots, sizeof(int));
+    fas.outCount = (int*)calloc(slots, sizeof(int));
+    fas.inWeight = (long long*)calloc(slots, sizeof(long long));
+    fas.outWeight = (long long*)calloc(slots, sizeof(long long));
+    fas.placed = (unsigned char*)calloc(slots, 1);
+    fas.sources = (int*)malloc(slots * sizeof(int));
+    fas.sinks = (int*)malloc(slots * sizeof(int));
+    fas.heap = (FasHeapEntry*)malloc((slots + 2 * (size_t)graph->numEdges) * sizeof(FasHeapEntry));
+    fas.reverse.offsets = NULL;
+    fas.reverse.targets = NULL;
+    fas.reverse.weights = NULL;
+    SccWorkspace ws;
+    int wsReady = sccWorkspaceInit(&ws, n) == 0;
+    long long cost = -1;
+    if (!sccId || !position || !fas.inCount || !fas.outCount || !fas.inWeight || !fas.outWeight ||
+        !fas.placed || !fas.sources || !fas.sinks || !fas.heap || !wsReady ||
+        csrTranspose(graph, &fas.reverse) != 0) {
+        goto cleanup;
+    }
+
+    sccCompute(graph, 0, sccId, &ws);
+    fas.sccId = sccId;
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            if (fasCounts(&fas, u, v)) {
+                fas.outCount[u]++;
+                fas.outWeight[u] += fasWeight(graph, e);
+                fas.inCount[v]++;
+                fas.inWeight[v] += fasWeight(graph, e);
+            }
+        }
+    }
+
+    fas.sourceCount = fas.sinkCount = fas.heapSize = 0;
+    for (int v = 0; v < n; v++) {
+        if (fas.outCount[v] == 0) {
+            fas.sinks[fas.sinkCount++] = v;
+        } else if (fas.inCount[v] == 0) {
+            fas.sources[fas.sourceCount++] = v;
+        } else {
+            fasHeapPush(fas.heap, &fas.heapSize, fas.outWeight[v] - fas.inWeight[v], v);
+        }
+    }
+
+    // Fill the sequence from both ends
+    int front = 0, back = n - 1;
+    while (front <= back) {
+        int x;
+        if (fas.sinkCount > 0) {
+            x = fas.sinks[--fas.sinkCount];
+            if (fas.placed[x]) {
+                continue;
+            }
+            position[x] = back--;
+        } else if (fas.sourceCount > 0) {
+            x = fas.sources[--fas.sourceCount];
+            if (fas.placed[x]) {
+                continue;
+            }
+            position[x] = front++;
+        } else {
+            FasHeapEntry top = fasHeapPop(fas.heap, &fas.heapSize);
+            x = top.vertex;
+            if (fas.placed[x] || top.key != fas.outWeight[x] - fas.inWeight[x]) {
+                continue;  // Stale entry
+            }
+            position[x] = front++;
+        }
+        fasRemoveVertex(&fas, x);
+    }
+
+    cost = 0;
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int v = graph->targets[e];
+            removed[e] = sccId[u] == sccId[v] && position[u] >= position[v];
+            if (removed[e]) {
+                cost += fasWeight(graph, e);
+            }
+        }
+    }
+
+cleanup:
+    if (wsReady) {
+        sccWorkspaceFree(&ws);
+    }
+    csrFree(&fas.reverse);
+    free(sccId);
+    free(position);
+    free(fas.inCount);
+    free(fas.outCount);
+    free(fas.inWeight);
+    free(fas.outWeight);
+    free(fas.placed);
+    free(fas.sources);
+    free(fas.sinks);
+    free(fas.heap);
+    return cost;
+}
+
+#endif // FEEDBACK_ARC_SET_H
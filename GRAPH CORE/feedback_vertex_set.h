@@ -0,0 +1,287 @@
+#ifndef FEEDBACK_VERTEX_SET_H
+#define FEEDBACK_VERTEX_SET_H
+
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "scc.h"
+
+#define FVS_UNBREAKABLE -2  // A cycle runs through non-candidate vertices only
+
+// Max-heap entry of a candidate's score; stale entries are skipped on pop
+typedef struct {
+    double key;
+    int vertex;
+} FvsHeapEntry;
+
+static inline void fvsHeapPush(FvsHeapEntry* heap, int* size, double key, int vertex) {
+    int i = (*size)++;
+    while (i > 0 && heap[(i - 1) / 2].key < key) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i].key = key;
+    heap[i].vertex = vertex;
+}
+
+static inline FvsHeapEntry fvsHeapPop(FvsHeapEntry* heap, int* size) {
+    FvsHeapEntry top = heap[0];
+    FvsHeapEntry last = heap[--(*size)];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= *size) {
+            break;
+        }
+        if (child + 1 < *size && heap[child + 1].key > heap[child].key) {
+            child++;
+        }
+        if (heap[child].key <= last.key) {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (*size > 0) {
+        heap[i] = last;
+    }
+    return top;
+}
+
+// Working state of one feedback vertex set computation.
+// The core is what survives trimming: every vertex in it has a live in-edge
+// and a live out-edge, so a non-empty core always contains a cycle. An edge
+// is live while both ends are in the core and, after the last SCC pass, both
+// ends lie in the same SCC; edges between SCCs are never on a cycle.
+typedef struct {
+    const CsrGraph* graph;
+    CsrGraph reverse;
+    const double* cost;
+    const unsigned char* candidate;
+    unsigned char* inCore;
+    int* sccId;
+    int* inDegree;
+    int* outDegree;
+    int* queue;
+    int coreSize;
+    FvsHeapEntry* heap;
+    int heapSize;
+    int heapCapacity;
+} FvsState;
+
+static inline int fvsLive(const FvsState* fvs, int u, int v) {
+    return fvs->inCore[u] && fvs->inCore[v] && fvs->sccId[u] == fvs->sccId[v];
+}
+
+// Score of a candidate: cycles it can break, estimated by in * out degree, per unit cost
+static inline double fvsScore(const FvsState* fvs, int v) {
+    return (double)fvs->inDegree[v] * fvs->outDegree[v] / fvs->cost[v];
+}
+
+static inline int fvsPushScore(FvsState* fvs, int v) {
+    if (!fvs->candidate[v]) {
+        return 0;
+    }
+    if (fvs->heapSize == fvs->heapCapacity) {
+        int capacity = 2 * fvs->heapCapacity;
+        FvsHeapEntry* heap = (FvsHeapEntry*)realloc(fvs->heap, capacity * sizeof(FvsHeapEntry));
+        if (!heap) {
+            return -1;
+        }
+        fvs->heap = heap;
+        fvs->heapCapacity = capacity;
+    }
+    fvsHeapPush(fvs->heap, &fvs->heapSize, fvsScore(fvs, v), v);
+    return 0;
+}
+
+// Function to drop x from the core and trim whatever loses its last live
+// in- or out-edge as a result. Returns 0 or -1.
+static inline int fvsRemove(FvsState* fvs, int x) {
+    const CsrGraph* graph = fvs->graph;
+    int front = 0, rear = 0;
+    fvs->queue[rear++] = x;
+    while (front < rear) {
+        int current = fvs->queue[front++];
+        // Degrees of current's neighbors drop while current still counts as in the core
+        for (int e = graph->offsets[current]; e < graph->offsets[current + 1]; e++) {
+            int next = graph->targets[e];
+            if (next != current && fvsLive(fvs, current, next)) {
+                fvs->inDegree[next]--;
+            }
+        }
+        for (int e = fvs->reverse.offsets[current]; e < fvs->reverse.offsets[current + 1]; e++) {
+            int previous = fvs->reverse.targets[e];
+            if (previous != current && fvsLive(fvs, previous, current)) {
+                fvs->outDegree[previous]--;
+            }
+        }
+        fvs->inCore[current] = 0;
+        fvs->coreSize--;
+
+        for (int e = graph->offsets[current]; e < graph->offsets[current + 1]; e++) {
+            int next = graph->targets[e];
+            if (fvs->inCore[next] == 1 && fvs->sccId[next] == fvs->sccId[current]) {
+                if (fvs->inDegree[next] == 0 || fvs->outDegree[next] == 0) {
+                    fvs->inCore[next] = 2;  // Queued; still counted until processed
+                    fvs->queue[rear++] = next;
+                } else if (fvsPushScore(fvs, next) != 0) {
+                    return -1;
+                }
+            }
+        }
+        for (int e = fvs->reverse.offsets[current]; e < fvs->reverse.offsets[current + 1]; e++) {
+            int previous = fvs->reverse.targets[e];
+            if (fvs->inCore[previous] == 1 && fvs->sccId[previous] == fvs->sccId[current]) {
+                if (fvs->inDegree[previous] == 0 || fvs->outDegree[previous] == 0) {
+                    fvs->inCore[previous] = 2;
+                    fvs->queue[rear++] = previous;
+                } else if (fvsPushScore(fvs, previous) != 0) {
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Function to recompute SCCs of the core, recount live degrees, trim, and
+// rebuild the heap. Returns 0 or -1.
+static inline int fvsRefresh(FvsState* fvs, SccWorkspace* ws, int* srcList, int* destList) {
+    const CsrGraph* graph = fvs->graph;
+    int n = graph->numVertices, kept = 0;
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            if (fvsLive(fvs, u, graph->targets[e])) {
+                srcList[kept] = u;
+                destList[kept] = graph->targets[e];
+                kept++;
+            }
+        }
+    }
+    CsrGraph core;
+    if (csrBuild(&core, n, kept, srcList, destList, NULL) != 0) {
+        return -1;
+    }
+    sccCompute(&core, 0, fvs->sccId, ws);
+
+    // Self-loops count too: a vertex with one is on a cycle of its own
+    for (int v = 0; v < n; v++) {
+        fvs->inDegree[v] = fvs->outDegree[v] = 0;
+    }
+    for (int u = 0; u < n; u++) {
+        for (int e = core.offsets[u]; e < core.offsets[u + 1]; e++) {
+            int v = core.targets[e];
+            if (fvs->sccId[u] == fvs->sccId[v]) {
+                fvs->outDegree[u]++;
+                fvs->inDegree[v]++;
+            }
+        }
+    }
+    csrFree(&core);
+
+    // Trim; each removal cascades to the neighbors it strands
+    for (int v = 0; v < n; v++) {
+        if (fvs->inCore[v] == 1 && (fvs->inDegree[v] == 0 || fvs->outDegree[v] == 0) && fvsRemove(fvs, v) != 0) {
+            return -1;
+        }
+    }
+    fvs->heapSize = 0;  // Rebuilt from scratch below
+    for (int v = 0; v < n; v++) {
+        if (fvs->inCore[v] == 1 && fvsPushScore(fvs, v) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Greedy weighted feedback vertex set over the candidate vertices.
+// Repeatedly removes the candidate with the highest in * out degree per unit
+// cost from the trimmed core; SCCs are recomputed after 1, 2, 4, ... removals
+// so edges between components stop inflating degrees. Costs must be positive.
+//
+// Sets victim[v] for the chosen vertices. Returns how many were chosen,
+// FVS_UNBREAKABLE if some cycle has no candidate on it, or -1 if allocation fails.
+static inline int csrFeedbackVertexSet(const CsrGraph* graph, const double* cost,
+                                       const unsigned char* candidate, unsigned char* victim) {
+    int n = graph->numVertices;
+    size_t slots = (size_t)n + 1;
+    FvsState fvs;
+    fvs.graph = graph;
+    fvs.cost = cost;
+    fvs.candidate = candidate;
+    fvs.inCore = (unsigned char*)malloc(slots);
+    fvs.sccId = (int*)calloc(slots, sizeof(int));
+    fvs.inDegree = (int*)malloc(slots * sizeof(int));
+    fvs.outDegree = (int*)malloc(slots * sizeof(int));
+    fvs.queue = (int*)malloc(slots * sizeof(int));
+    fvs.heapCapacity = (int)slots;
+    fvs.heapSize = 0;
+    fvs.coreSize = 0;
+    fvs.heap = (FvsHeapEntry*)malloc(slots * sizeof(FvsHeapEntry));
+    fvs.reverse.offsets = NULL;
+    fvs.reverse.targets = NULL;
+    fvs.reverse.weights = NULL;
+    int* srcList = (int*)malloc(((size_t)graph->numEdges + 1) * sizeof(int));
+    int* destList = (int*)malloc(((size_t)graph->numEdges + 1) * sizeof(int));
+    SccWorkspace ws;
+    int wsReady = sccWorkspaceInit(&ws, n) == 0;
+    int chosen = -1;
+    if (!fvs.inCore || !fvs.sccId || !fvs.inDegree || !fvs.outDegree || !fvs.queue || !fvs.heap ||
+        !srcList || !destList || !wsReady || csrTranspose(graph, &fvs.reverse) != 0) {
+        goto cleanup;
+    }
+
+    for (int v = 0; v < n; v++) {
+        fvs.inCore[v] = 1;
+        victim[v] = 0;
+    }
+    fvs.coreSize = n;
+    if (fvsRefresh(&fvs, &ws, srcList, destList) != 0) {
+        goto cleanup;
+    }
+
+    chosen = 0;
+    int nextRefresh = 1;
+    while (fvs.coreSize > 0) {
+        if (fvs.heapSize == 0) {
+            chosen = FVS_UNBREAKABLE;  // The core is cyclic but holds no candidate
+            break;
+        }
+        FvsHeapEntry top = fvsHeapPop(fvs.heap, &fvs.heapSize);
+        int v = top.vertex;
+        if (fvs.inCore[v] != 1 || top.key != fvsScore(&fvs, v)) {
+            continue;  // Stale entry
+        }
+        victim[v] = 1;
+        chosen++;
+        if (fvsRemove(&fvs, v) != 0) {
+            chosen = -1;
+            break;
+        }
+        if (chosen == nextRefresh && fvs.coreSize > 0) {
+            nextRefresh *= 2;
+            if (fvsRefresh(&fvs, &ws, srcList, destList) != 0) {
+                chosen = -1;
+                break;
+            }
+        }
+    }
+
+cleanup:
+    if (wsReady) {
+        sccWorkspaceFree(&ws);
+    }
+    csrFree(&fvs.reverse);
+    free(fvs.inCore);
+    free(fvs.sccId);
+    free(fvs.inDegree);
+    free(fvs.outDegree);
+    free(fvs.queue);
+    free(fvs.heap);
+    free(srcList);
+    free(destList);
+    return chosen;
+}
+
+#endif // FEEDBACK_VERTEX_SET_H
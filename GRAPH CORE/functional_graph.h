@@ -0,0 +1,135 @@
+#ifndef FUNCTIONAL_GRAPH_H
+#define FUNCTIONAL_GRAPH_H
+
+#include <stdlib.h>
+
+// Functional graphs: every vertex has at most one out-edge, stored as
+// next[v] (-1 if none). This is the shape of a resource allocation graph when
+// each blocked process waits on one resource and each resource has one
+// holder. Following next from any vertex either stops or runs into a single
+// cycle, so cycles are found by pointer chasing, with no adjacency structure.
+
+// Function to fill next from an edge list. Repeated copies of an edge are
+// fine. Returns -1 if every vertex has at most one distinct out-edge, or
+// else the first vertex with two, in which case next is incomplete.
+static inline int functionalFromEdges(int numVertices, int numEdges, const int* src, const int* dest, int* next) {
+    for (int v = 0; v < numVertices; v++) {
+        next[v] = -1;
+    }
+    for (int i = 0; i < numEdges; i++) {
+        if (next[src[i]] != -1 && next[src[i]] != dest[i]) {
+            return src[i];
+        }
+        next[src[i]] = dest[i];
+    }
+    return -1;
+}
+
+// Called with one vertex of each cycle; walk next from it to list the cycle.
+// A nonzero return stops the search.
+typedef int (*FunctionalCycleCallback)(int entry, void* context);
+
+// Function to find every cycle in O(V) time with one int per vertex. Each
+// unvisited vertex starts a walk that stamps mark[v] = start + 1 until it
+// stops, reaches an earlier walk, or meets its own stamp, which closes a
+// new cycle. Returns the number of cycles reported.
+static inline int functionalFindCycles(const int* next, int numVertices, int* mark,
+                                       FunctionalCycleCallback onCycle, void* context) {
+    int cycles = 0;
+    for (int v = 0; v < numVertices; v++) {
+        mark[v] = 0;
+    }
+    for (int s = 0; s < numVertices; s++) {
+        int v = s;
+        while (v != -1 && mark[v] == 0) {
+            mark[v] = s + 1;
+            v = next[v];
+        }
+        if (v != -1 && mark[v] == s + 1) {
+            cycles++;
+            if (onCycle && onCycle(v, context) != 0) {
+                break;
+            }
+        }
+    }
+    return cycles;
+}
+
+// Online variant for edges that arrive one at a time. Union-find over the
+// weak components keeps, for each one, its sink: the only vertex without an
+// out-edge, or -1 once the component holds its cycle. A new edge u -> v is
+// legal only from a sink, and closes a cycle exactly when v's component
+// sinks into u. With union by size and path halving each insertion costs
+// near-constant amortized time. Edges are never removed.
+typedef struct {
+    int numVertices;
+    int* next;
+    int* parent;  // Negative size at a representative
+    int* sink;    // Valid at representatives
+} FunctionalForest;
+
+static inline void functionalForestFree(FunctionalForest* forest) {
+    free(forest->next);
+    free(forest->parent);
+    free(forest->sink);
+    forest->next = forest->parent = forest->sink = NULL;
+}
+
+// Function to start a forest of isolated vertices. Returns 0 or -1.
+static inline int functionalForestInit(FunctionalForest* forest, int numVertices) {
+    forest->numVertices = numVertices;
+    forest->next = (int*)malloc(((size_t)numVertices + 1) * sizeof(int));
+    forest->parent = (int*)malloc(((size_t)numVertices + 1) * sizeof(int));
+    forest->sink = (int*)malloc(((size_t)numVertices + 1) * sizeof(int));
+    if (!forest->next || !forest->parent || !forest->sink) {
+        functionalForestFree(forest);
+        return -1;
+    }
+    for (int v = 0; v < numVertices; v++) {
+        forest->next[v] = -1;
+        forest->parent[v] = -1;
+        forest->sink[v] = v;
+    }
+    return 0;
+}
+
+static inline int functionalForestFind(FunctionalForest* forest, int v) {
+    while (forest->parent[v] >= 0) {
+        int up = forest->parent[v];
+        if (forest->parent[up] >= 0) {
+            forest->parent[v] = forest->parent[up];
+        }
+        v = up;
+    }
+    return v;
+}
+
+// Function to add the edge u -> v. Returns 1 if it closes a cycle (the cycle
+// runs from v along next back to u), 0 if not, 0 for a repeat of the edge
+// already there, or -1 if u already waits on some other vertex.
+static inline int functionalForestInsert(FunctionalForest* forest, int u, int v) {
+    if (forest->next[u] != -1) {
+        return forest->next[u] == v ? 0 : -1;
+    }
+    forest->next[u] = v;
+
+    int ru = functionalForestFind(forest, u), rv = functionalForestFind(forest, v);
+    if (ru == rv) {
+        forest->sink[ru] = -1;  // u was the sink, so v already reaches u
+        return 1;
+    }
+
+    // u's component now drains into v's, so the merged sink is v's
+    int sink = forest->sink[rv];
+    if (forest->parent[ru] > forest->parent[rv]) {
+        int swap = ru;
+        ru = rv;
+        rv = swap;
+    }
+    forest->parent[ru] += forest->parent[rv];
+    forest->parent[rv] = ru;
+    forest->sink[ru] = sink;
+    return 0;
+}
+
+#endif // FUNCTIONAL_GRAPH_H
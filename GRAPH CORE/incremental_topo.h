@@ -0,0 +1,190 @@
+#ifndef INCREMENTAL_TOPO_H
+#define INCREMENTAL_TOPO_H
+
+#include <stdlib.h>
+
+#include "int_vector.h"
+
+// Online cycle detection with the Pearce-Kelly dynamic topological order.
+// ord[v] is v's position in a topological order of the current graph and
+// node[p] the vertex at position p. Inserting u -> v with ord[u] < ord[v]
+// costs O(1). Otherwise only the affected region ord[v]..ord[u] is searched
+// (forward from v, backward from u) and the visited vertices are shuffled
+// among their own positions; the rest of the order is untouched.
+typedef struct {
+    int numVertices;
+    IntVector* out;   // Successors of each vertex
+    IntVector* in;    // Predecessors, for the backward search
+    int* ord;
+    int* node;
+    int* mark;        // Visit epoch per vertex, so nothing is cleared per insert
+    int epoch;
+    int* parent;      // Forward-search tree, used to report the cycle path
+    int* stack;
+    int* deltaF;      // Forward-reached vertices, then their sorted positions
+    int* deltaB;      // Backward-reached vertices, then their sorted positions
+    int* merged;
+    int* reordered;
+} IncrementalTopo;
+
+static inline void itFree(IncrementalTopo* topo) {
+    for (int v = 0; v < topo->numVertices; v++) {
+        free(topo->out[v].items);
+        free(topo->in[v].items);
+    }
+    free(topo->out);
+    free(topo->in);
+    free(topo->ord);
+    free(topo->node);
+    free(topo->mark);
+    free(topo->parent);
+    free(topo->stack);
+    free(topo->deltaF);
+    free(topo->deltaB);
+    free(topo->merged);
+    free(topo->reordered);
+}
+
+// Function to start from an edgeless graph whose topological order is
+// given by order (for example Kahn's order of an initial acyclic graph).
+// Returns 0 on success, -1 if allocation fails.
+static inline int itInit(IncrementalTopo* topo, int numVertices, const int* order) {
+    size_t n = (size_t)numVertices + 1;
+    topo->numVertices = numVertices;
+    topo->epoch = 0;
+    topo->out = (IntVector*)calloc(n, sizeof(IntVector));
+    topo->in = (IntVector*)calloc(n, sizeof(IntVector));
+    topo->ord = (int*)malloc(n * sizeof(int));
+    topo->node = (int*)malloc(n * sizeof(int));
+    topo->mark = (int*)calloc(n, sizeof(int));
+    topo->parent = (int*)malloc(n * sizeof(int));
+    topo->stack = (int*)malloc(n * sizeof(int));
+    topo->deltaF = (int*)malloc(n * sizeof(int));
+    topo->deltaB = (int*)malloc(n * sizeof(int));
+    topo->merged = (int*)malloc(n * sizeof(int));
+    topo->reordered = (int*)malloc(n * sizeof(int));
+    if (!topo->out || !topo->in || !topo->ord || !topo->node || !topo->mark || !topo->parent ||
+        !topo->stack || !topo->deltaF || !topo->deltaB || !topo->merged || !topo->reordered) {
+        topo->numVertices = 0;
+        itFree(topo);
+        return -1;
+    }
+    for (int p = 0; p < numVertices; p++) {
+        topo->node[p] = order[p];
+        topo->ord[order[p]] = p;
+    }
+    return 0;
+}
+
+// Function to record an edge that is known to respect the current order
+static inline int itAddEdgeUnchecked(IncrementalTopo* topo, int u, int v) {
+    if (intVectorPush(&topo->out[u], v) != 0 || intVectorPush(&topo->in[v], u) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static inline int itCompareInts(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Function to insert u -> v unless it closes a cycle.
+// Returns 1 if the edge was inserted, 0 if it was rejected because it closes
+// a cycle (cycle then holds u, v, ..., the path back to u, and *cycleLength
+// its length), or -1 if allocation fails.
+static inline int itInsertEdge(IncrementalTopo* topo, int u, int v, int* cycle, int* cycleLength) {
+    if (u == v) {
+        cycle[0] = u;
+        *cycleLength = 1;
+        return 0;
+    }
+
+    int lb = topo->ord[v], ub = topo->ord[u];
+    if (lb > ub) {
+        return itAddEdgeUnchecked(topo, u, v) == 0 ? 1 : -1;  // Already in order
+    }
+
+    // Forward search from v, limited to positions below ub
+    int epoch = ++topo->epoch;
+    int top = 0, countF = 0, countB = 0;
+    topo->stack[top++] = v;
+    topo->mark[v] = epoch;
+    topo->parent[v] = -1;
+    while (top > 0) {
+        int x = topo->stack[--top];
+        topo->deltaF[countF++] = x;
+        for (int i = 0; i < topo->out[x].size; i++) {
+            int w = topo->out[x].items[i];
+            if (w == u) {
+                // v reaches u: report u -> v -> ... -> x -> u
+                int length = 0;
+                for (int y = x; y != -1; y = topo->parent[y]) {
+                    topo->reordered[length++] = y;
+                }
+                cycle[0] = u;
+                for (int k = 0; k < length; k++) {
+                    cycle[k + 1] = topo->reordered[length - 1 - k];
+                }
+                *cycleLength = length + 1;
+                return 0;
+            }
+            if (topo->mark[w] != epoch && topo->ord[w] < ub) {
+                topo->mark[w] = epoch;
+                topo->parent[w] = x;
+                topo->stack[top++] = w;
+            }
+        }
+    }
+
+    // Backward search from u, limited to positions above lb
+    top = 0;
+    topo->stack[top++] = u;
+    topo->mark[u] = epoch;
+    while (top > 0) {
+        int x = topo->stack[--top];
+        topo->deltaB[countB++] = x;
+        for (int i = 0; i < topo->in[x].size; i++) {
+            int w = topo->in[x].items[i];
+            if (topo->mark[w] != epoch && topo->ord[w] > lb) {
+                topo->mark[w] = epoch;
+                topo->stack[top++] = w;
+            }
+        }
+    }
+
+    // Reorder: everything that reaches u moves ahead of everything v reaches,
+    // reusing exactly the positions the two sets occupied
+    for (int i = 0; i < countF; i++) {
+        topo->deltaF[i] = topo->ord[topo->deltaF[i]];
+    }
+    for (int i = 0; i < countB; i++) {
+        topo->deltaB[i] = topo->ord[topo->deltaB[i]];
+    }
+    qsort(topo->deltaF, countF, sizeof(int), itCompareInts);
+    qsort(topo->deltaB, countB, sizeof(int), itCompareInts);
+
+    int count = 0;
+    for (int i = 0; i < countB; i++) {
+        topo->reordered[count++] = topo->node[topo->deltaB[i]];
+    }
+    for (int i = 0; i < countF; i++) {
+        topo->reordered[count++] = topo->node[topo->deltaF[i]];
+    }
+    int i = 0, j = 0, k = 0;
+    while (i < countB || j < countF) {
+        if (j == countF || (i < countB && topo->deltaB[i] < topo->deltaF[j])) {
+            topo->merged[k++] = topo->deltaB[i++];
+        } else {
+            topo->merged[k++] = topo->deltaF[j++];
+        }
+    }
+    for (k = 0; k < count; k++) {
+        topo->ord[topo->reordered[k]] = topo->merged[k];
+        topo->node[topo->merged[k]] = topo->reordered[k];
+    }
+
+    return itAddEdgeUnchecked(topo, u, v) == 0 ? 1 : -1;
+}
+
+#endif // INCREMENTAL_TOPO_H
@@ -0,0 +1,28 @@
+#ifndef INT_VECTOR_H
+#define INT_VECTOR_H
+
+#include <stdlib.h>
+
+// Growable array of ints
+typedef struct {
+    int* items;
+    int size;
+    int capacity;
+} IntVector;
+
+// Function to append a value, doubling the capacity when full. Returns 0 or -1.
+static inline int intVectorPush(IntVector* vector, int value) {
+    if (vector->size == vector->capacity) {
+        int capacity = vector->capacity ? 2 * vector->capacity : 4;
+        int* items = (int*)realloc(vector->items, capacity * sizeof(int));
+        if (!items) {
+            return -1;
+        }
+        vector->items = items;
+        vector->capacity = capacity;
+    }
+    vector->items[vector->size++] = value;
+    return 0;
+}
+
+#endif // INT_VECTOR_H
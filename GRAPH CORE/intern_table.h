@@ -0,0 +1,168 @@
+#ifndef INTERN_TABLE_H
+#define INTERN_TABLE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_NAME_LENGTH 64  // Longest process/resource name read from input, including '\0'
+
+// Interning table mapping arbitrary-length names to dense ids 0, 1, 2, ...
+// Names live back to back in one growing arena and are addressed by offset.
+// Lookups use open addressing with linear probing over a power-of-two slot
+// array kept at most half full, so loading E edges costs O(E) expected time.
+typedef struct {
+    char* arena;          // All names, each terminated by '\0'
+    size_t arenaUsed;
+    size_t arenaCapacity;
+    size_t* nameOffsets;  // Arena offset of each id's name
+    uint32_t* nameHashes; // Hash of each id's name, reused when the table grows
+    int count;
+    int idCapacity;
+    uint32_t* slots;      // id + 1 per slot, 0 for an empty slot
+    uint32_t slotMask;
+} InternTable;
+
+// FNV-1a hash of a name
+static inline uint32_t internHash(const char* name, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Function to release the table
+static inline void internFree(InternTable* table) {
+    free(table->arena);
+    free(table->nameOffsets);
+    free(table->nameHashes);
+    free(table->slots);
+    memset(table, 0, sizeof(*table));
+}
+
+// Function to set up an empty table sized for about expectedNames names.
+// Returns 0 on success, -1 if allocation fails.
+static inline int internInit(InternTable* table, int expectedNames) {
+    memset(table, 0, sizeof(*table));
+    if (expectedNames < 16) {
+        expectedNames = 16;
+    }
+
+    uint32_t slotCount = 32;
+    while (slotCount < 2u * (uint32_t)expectedNames) {
+        slotCount <<= 1;
+    }
+
+    table->idCapacity = expectedNames;
+    table->arenaCapacity = (size_t)expectedNames * 8;
+    table->arena = (char*)malloc(table->arenaCapacity);
+    table->nameOffsets = (size_t*)malloc(table->idCapacity * sizeof(size_t));
+    table->nameHashes = (uint32_t*)malloc(table->idCapacity * sizeof(uint32_t));
+    table->slots = (uint32_t*)calloc(slotCount, sizeof(uint32_t));
+    table->slotMask = slotCount - 1;
+    if (!table->arena || !table->nameOffsets || !table->nameHashes || !table->slots) {
+        internFree(table);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to get the name of an id. The pointer stays valid until the next add.
+static inline const char* internName(const InternTable* table, int id) {
+    return table->arena + table->nameOffsets[id];
+}
+
+// Function to find the slot holding name, or the empty slot where it would go
+static inline uint32_t internProbe(const InternTable* table, const char* name, uint32_t hash) {
+    uint32_t slot = hash & table->slotMask;
+    while (table->slots[slot] != 0) {
+        int id = (int)table->slots[slot] - 1;
+        if (table->nameHashes[id] == hash && strcmp(internName(table, id), name) == 0) {
+            break;
+        }
+        slot = (slot + 1) & table->slotMask;
+    }
+    return slot;
+}
+
+// Function to look up a name, returns its id or -1 if it was never added
+static inline int internLookup(const InternTable* table, const char* name) {
+    uint32_t slot = internProbe(table, name, internHash(name, strlen(name)));
+    return (int)table->slots[slot] - 1;
+}
+
+// Function to double the slot array and reinsert every id from its saved hash
+static inline int internGrowSlots(InternTable* table) {
+    uint32_t slotCount = (table->slotMask + 1) * 2;
+    uint32_t* slots = (uint32_t*)calloc(slotCount, sizeof(uint32_t));
+    if (!slots) {
+        return -1;
+    }
+    for (int id = 0; id < table->count; id++) {
+        uint32_t slot = table->nameHashes[id] & (slotCount - 1);
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        slots[slot] = (uint32_t)id + 1;
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->slotMask = slotCount - 1;
+    return 0;
+}
+
+// Function to return the id of name, adding it with the next dense id if new.
+// Returns -1 if the table cannot grow.
+static inline int internAdd(InternTable* table, const char* name) {
+    size_t length = strlen(name);
+    uint32_t hash = internHash(name, length);
+    uint32_t slot = internProbe(table, name, hash);
+    if (table->slots[slot] != 0) {
+        return (int)table->slots[slot] - 1;
+    }
+
+    // Grow the id arrays and the arena geometrically
+    if (table->count == table->idCapacity) {
+        int capacity = table->idCapacity * 2;
+        size_t* offsets = (size_t*)realloc(table->nameOffsets, capacity * sizeof(size_t));
+        if (!offsets) {
+            return -1;
+        }
+        table->nameOffsets = offsets;
+        uint32_t* hashes = (uint32_t*)realloc(table->nameHashes, capacity * sizeof(uint32_t));
+        if (!hashes) {
+            return -1;
+        }
+        table->nameHashes = hashes;
+        table->idCapacity = capacity;
+    }
+    if (table->arenaUsed + length + 1 > table->arenaCapacity) {
+        size_t capacity = table->arenaCapacity * 2;
+        while (table->arenaUsed + length + 1 > capacity) {
+            capacity *= 2;
+        }
+        char* arena = (char*)realloc(table->arena, capacity);
+        if (!arena) {
+            return -1;
+        }
+        table->arena = arena;
+        table->arenaCapacity = capacity;
+    }
+
+    int id = table->count++;
+    memcpy(table->arena + table->arenaUsed, name, length + 1);
+    table->nameOffsets[id] = table->arenaUsed;
+    table->nameHashes[id] = hash;
+    table->arenaUsed += length + 1;
+    table->slots[slot] = (uint32_t)id + 1;
+
+    // Keep the load factor at or below one half
+    if (2u * (uint32_t)table->count > table->slotMask + 1 && internGrowSlots(table) != 0) {
+        return -1;
+    }
+    return id;
+}
+
+#endif // INTERN_TABLE_H
@@ -0,0 +1,275 @@
+#ifndef JOHNSON_CYCLES_H
+#define JOHNSON_CYCLES_H
+
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "scc.h"
+
+// Called once per elementary cycle, as soon as it is found. cycle holds the
+// vertex ids in order (the closing vertex is not repeated). Return nonzero to
+// stop the enumeration early.
+typedef int (*CycleCallback)(const int* cycle, int length, void* context);
+
+// Bounds on the enumeration, 0 means unlimited
+typedef struct {
+    long long maxCycles;  // Stop after this many cycles
+    int maxLength;        // Only report cycles with at most this many vertices
+} CycleLimits;
+
+// Johnson's blocked-vertex bookkeeping for one strongly connected component.
+// B lists live in one node pool threaded through next[], so no allocation
+// happens while a circuit search is running.
+typedef struct {
+    char* blocked;
+    int* bHead;       // First B-list node of each vertex, -1 if empty
+    int* bVertex;     // Node pool: the vertex recorded in a B list
+    int* bNext;       // Node pool: next node in the same B list
+    int bFree;        // Head of the free-node list
+    int bUsed;        // Nodes handed out from the never-used tail of the pool
+    int* unblockStack;
+    DfsFrame* frames;
+    char* found;      // Whether the search below each frame closed a cycle
+    int* cycle;       // Global ids of the cycle being reported
+} JohnsonState;
+
+static inline void johnsonStateFree(JohnsonState* st) {
+    free(st->blocked);
+    free(st->bHead);
+    free(st->bVertex);
+    free(st->bNext);
+    free(st->unblockStack);
+    free(st->frames);
+    free(st->found);
+    free(st->cycle);
+}
+
+// Function to add v to the B list of w unless it is already there
+static inline void johnsonAddToB(JohnsonState* st, int w, int v) {
+    for (int node = st->bHead[w]; node != -1; node = st->bNext[node]) {
+        if (st->bVertex[node] == v) {
+            return;
+        }
+    }
+    int node;
+    if (st->bFree != -1) {
+        node = st->bFree;
+        st->bFree = st->bNext[node];
+    } else {
+        node = st->bUsed++;
+    }
+    st->bVertex[node] = v;
+    st->bNext[node] = st->bHead[w];
+    st->bHead[w] = node;
+}
+
+// Function to unblock u and, transitively, everything waiting on it in B lists
+static inline void johnsonUnblock(JohnsonState* st, int u) {
+    int top = 0;
+    st->unblockStack[top++] = u;
+    while (top > 0) {
+        int x = st->unblockStack[--top];
+        if (!st->blocked[x]) {
+            continue;
+        }
+        st->blocked[x] = 0;
+        int node = st->bHead[x];
+        while (node != -1) {
+            int next = st->bNext[node];
+            if (st->blocked[st->bVertex[node]]) {
+                st->unblockStack[top++] = st->bVertex[node];
+            }
+            st->bNext[node] = st->bFree;
+            st->bFree = node;
+            node = next;
+        }
+        st->bHead[x] = -1;
+    }
+}
+
+// Function to enumerate the cycles through s whose other vertices lie in the
+// same local component as s and are all greater than s. members maps local
+// ids back to global ids. Returns 1 if the enumeration must stop.
+static inline int johnsonCircuits(const CsrGraph* local, int s, const int* localScc, const int* members,
+                                  JohnsonState* st, const CycleLimits* limits, long long* count,
+                                  CycleCallback emit, void* context) {
+    int component = localScc[s];
+    int top = 0;
+    st->frames[0].vertex = s;
+    st->frames[0].cursor = local->offsets[s];
+    st->found[0] = 0;
+    st->blocked[s] = 1;
+
+    while (top >= 0) {
+        DfsFrame* frame = &st->frames[top];
+        int v = frame->vertex;
+
+        if (frame->cursor < local->offsets[v + 1]) {
+            int w = local->targets[frame->cursor++];
+            if (localScc[w] != component) {
+                continue;
+            }
+            if (w == s) {
+                // Closed a cycle: report the path on the frame stack
+                for (int i = 0; i <= top; i++) {
+                    st->cycle[i] = members[st->frames[i].vertex];
+                }
+                st->found[top] = 1;
+                (*count)++;
+                if (emit(st->cycle, top + 1, context) != 0) {
+                    return 1;
+                }
+                if (limits->maxCycles > 0 && *count >= limits->maxCycles) {
+                    return 1;
+                }
+            } else if (!st->blocked[w]) {
+                if (limits->maxLength > 0 && top + 2 > limits->maxLength) {
+                    // Too deep to explore. Count it as found so v is unblocked
+                    // and can still be reached later along a shorter path.
+                    st->found[top] = 1;
+                    continue;
+                }
+                top++;
+                st->frames[top].vertex = w;
+                st->frames[top].cursor = local->offsets[w];
+                st->found[top] = 0;
+                st->blocked[w] = 1;
+            }
+            continue;
+        }
+
+        // v is finished
+        if (st->found[top]) {
+            johnsonUnblock(st, v);
+        } else {
+            for (int e = local->offsets[v]; e < local->offsets[v + 1]; e++) {
+                int w = local->targets[e];
+                if (localScc[w] == component) {
+                    johnsonAddToB(st, w, v);
+                }
+            }
+        }
+        char childFound = st->found[top];
+        top--;
+        if (top >= 0 && childFound) {
+            st->found[top] = 1;
+        }
+    }
+    return 0;
+}
+
+// Function to enumerate every elementary cycle of the graph with Johnson's
+// algorithm, one strongly connected component at a time. Each cycle is passed
+// to emit as soon as it is found, so memory stays O(V + E) however many cycles
+// there are. Repeated edges count once, so each cycle is reported once.
+// Returns the number of cycles reported, or -1 if allocation fails.
+static inline long long johnsonEnumerate(const CsrGraph* graph, const CycleLimits* limits,
+                                         CycleCallback emit, void* context) {
+    int n = graph->numVertices;
+    long long count = 0;
+    int stopped = 0;
+
+    int* sccId = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* memberStart = (int*)calloc((size_t)n + 2, sizeof(int));
+    int* members = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* localId = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* localScc = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* lastSource = (int*)malloc(((size_t)n + 1) * sizeof(int));  // Row that last kept each local target
+    int* srcList = (int*)malloc(((size_t)graph->numEdges + 1) * sizeof(int));
+    int* destList = (int*)malloc(((size_t)graph->numEdges + 1) * sizeof(int));
+    SccWorkspace ws = {0};
+    JohnsonState st = {0};
+    st.blocked = (char*)calloc((size_t)n + 1, sizeof(char));
+    st.bHead = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    st.bVertex = (int*)malloc(((size_t)graph->numEdges + 1) * sizeof(int));
+    st.bNext = (int*)malloc(((size_t)graph->numEdges + 1) * sizeof(int));
+    st.unblockStack = (int*)malloc(((size_t)graph->numEdges + n + 1) * sizeof(int));
+    st.frames = (DfsFrame*)malloc(((size_t)n + 1) * sizeof(DfsFrame));
+    st.found = (char*)malloc(((size_t)n + 1) * sizeof(char));
+    st.cycle = (int*)malloc(((size_t)n + 1) * sizeof(int));
+
+    if (!sccId || !memberStart || !members || !localId || !localScc || !lastSource || !srcList || !destList ||
+        !st.blocked || !st.bHead || !st.bVertex || !st.bNext || !st.unblockStack ||
+        !st.frames || !st.found || !st.cycle || sccWorkspaceInit(&ws, n) != 0) {
+        count = -1;
+        goto cleanup;
+    }
+
+    // Group vertices by component with a counting sort
+    int components = sccCompute(graph, 0, sccId, &ws);
+    for (int v = 0; v < n; v++) {
+        memberStart[sccId[v] + 2]++;
+        localId[v] = -1;
+    }
+    for (int c = 0; c < components; c++) {
+        memberStart[c + 2] += memberStart[c + 1];
+    }
+    for (int v = 0; v < n; v++) {
+        members[memberStart[sccId[v] + 1]++] = v;
+    }
+
+    for (int c = 0; c < components && !stopped; c++) {
+        const int* comp = members + memberStart[c];
+        int k = memberStart[c + 1] - memberStart[c];
+
+        // Induced subgraph of the component, relabelled 0..k-1. Repeated
+        // edges are kept once, or every copy would report the same cycles again.
+        for (int i = 0; i < k; i++) {
+            localId[comp[i]] = i;
+            lastSource[i] = -1;
+        }
+        int localEdges = 0;
+        for (int i = k - 1; i >= 0; i--) {
+            int u = comp[i];
+            for (int e = graph->offsets[u + 1] - 1; e >= graph->offsets[u]; e--) {
+                int w = localId[graph->targets[e]];
+                if (w != -1 && lastSource[w] != i) {
+                    lastSource[w] = i;
+                    srcList[localEdges] = i;
+                    destList[localEdges] = w;
+                    localEdges++;
+                }
+            }
+        }
+        for (int i = 0; i < k; i++) {
+            localId[comp[i]] = -1;
+        }
+        if (localEdges == 0) {
+            continue;  // A single vertex without a self-loop has no cycle
+        }
+
+        CsrGraph local;
+        if (csrBuild(&local, k, localEdges, srcList, destList, NULL) != 0) {
+            count = -1;
+            goto cleanup;
+        }
+
+        // Johnson: cycles whose least vertex is s, in the SCC of s within {s..k-1}
+        for (int s = 0; s < k && !stopped; s++) {
+            sccCompute(&local, s, localScc, &ws);
+            for (int i = s; i < k; i++) {
+                st.blocked[i] = 0;
+                st.bHead[i] = -1;
+            }
+            st.bFree = -1;
+            st.bUsed = 0;
+            stopped = johnsonCircuits(&local, s, localScc, comp, &st, limits, &count, emit, context);
+        }
+        csrFree(&local);
+    }
+
+cleanup:
+    free(sccId);
+    free(memberStart);
+    free(members);
+    free(localId);
+    free(localScc);
+    free(lastSource);
+    free(srcList);
+    free(destList);
+    sccWorkspaceFree(&ws);
+    johnsonStateFree(&st);
+    return count;
+}
+
+#endif // JOHNSON_CYCLES_H
@@ -0,0 +1,104 @@
+#ifndef KAHN_H
+#define KAHN_H
+
+#include <stdlib.h>
+
+#include "csr_graph.h"
+
+// Function to compute in-degrees of every vertex from the CSR targets
+static inline void csrInDegrees(const CsrGraph* graph, int* inDegree) {
+    for (int v = 0; v < graph->numVertices; v++) {
+        inDegree[v] = 0;
+    }
+    for (int e = 0; e < graph->numEdges; e++) {
+        inDegree[graph->targets[e]]++;
+    }
+}
+
+// Kahn's algorithm: writes vertices to order as their in-degree drops to zero.
+// The order array doubles as the queue. Returns how many vertices were ordered;
+// fewer than numVertices means the rest lie on or behind a cycle.
+// Returns -1 if allocation fails.
+static inline int csrKahnOrder(const CsrGraph* graph, int* order) {
+    int n = graph->numVertices;
+    int* inDegree = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    if (!inDegree) {
+        return -1;
+    }
+    csrInDegrees(graph, inDegree);
+
+    // Enqueue vertices with zero in-degree
+    int front = 0, rear = 0;
+    for (int v = 0; v < n; v++) {
+        if (inDegree[v] == 0) {
+            order[rear++] = v;
+        }
+    }
+
+    // Process each vertex in the queue
+    while (front < rear) {
+        int current = order[front++];
+        for (int e = graph->offsets[current]; e < graph->offsets[current + 1]; e++) {
+            int adjVertex = graph->targets[e];
+            if (--inDegree[adjVertex] == 0) {
+                order[rear++] = adjVertex;
+            }
+        }
+    }
+
+    free(inDegree);
+    return rear;
+}
+
+// Function to tell whether edge e out of u survives the removals below
+static inline int csrKahnEdgeLive(const CsrGraph* graph, const unsigned char* removedEdge,
+                                  const unsigned char* removedVertex, int u, int e) {
+    return !(removedEdge && removedEdge[e]) &&
+           !(removedVertex && (removedVertex[u] || removedVertex[graph->targets[e]]));
+}
+
+// Function to check that no cycle is left once the flagged edges, and every
+// edge touching a flagged vertex, are taken out. Either flag array may be
+// NULL. Kahn's algorithm runs over the live edges in place, so no residual
+// graph is built. Returns 1 if acyclic, 0 if a cycle remains, or -1 if
+// allocation fails.
+static inline int csrIsAcyclicWithout(const CsrGraph* graph, const unsigned char* removedEdge,
+                                      const unsigned char* removedVertex) {
+    int n = graph->numVertices;
+    int* inDegree = (int*)calloc((size_t)n + 1, sizeof(int));
+    int* queue = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    if (!inDegree || !queue) {
+        free(inDegree);
+        free(queue);
+        return -1;
+    }
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            if (csrKahnEdgeLive(graph, removedEdge, removedVertex, u, e)) {
+                inDegree[graph->targets[e]]++;
+            }
+        }
+    }
+
+    int front = 0, rear = 0;
+    for (int v = 0; v < n; v++) {
+        if (inDegree[v] == 0) {
+            queue[rear++] = v;
+        }
+    }
+    while (front < rear) {
+        int current = queue[front++];
+        for (int e = graph->offsets[current]; e < graph->offsets[current + 1]; e++) {
+            if (csrKahnEdgeLive(graph, removedEdge, removedVertex, current, e) &&
+                --inDegree[graph->targets[e]] == 0) {
+                queue[rear++] = graph->targets[e];
+            }
+        }
+    }
+
+    free(inDegree);
+    free(queue);
+    return rear == n;
+}
+
+#endif // KAHN_H
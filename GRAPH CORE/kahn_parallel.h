@@ -0,0 +1,200 @@
+#ifndef KAHN_PARALLEL_H
+#define KAHN_PARALLEL_H
+
+// Level-synchronous parallel Kahn's algorithm. Compile with -pthread.
+// The barriers are POSIX, not C11: with -std=c11 the program must define
+// _POSIX_C_SOURCE 200112L before its first include.
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "int_vector.h"
+#include "kahn.h"
+
+// Shared state of one parallel Kahn run.
+// The order array holds the frontiers back to back: order[front..rear) is the
+// current level. Every thread takes a slice of it, decrements the in-degree
+// of each successor with a relaxed atomic, and keeps the vertices that reach
+// zero in its own buffer. After a barrier the buffers are copied to
+// order[rear..) at offsets given by a prefix sum of their sizes, so the next
+// frontier is built without locks.
+typedef struct {
+    const CsrGraph* graph;
+    int numThreads;
+    int* order;
+    _Atomic int* inDegree;
+    int* counts;             // Buffer size of each thread for the current level
+    pthread_barrier_t barrier;
+    pthread_mutex_t gateLock;   // Workers wait here until every thread is created
+    pthread_cond_t gateOpen;
+    int gate;                   // 0 while starting, 1 to run, -1 to give up
+    _Atomic int failed;      // Set if a thread could not grow its buffer
+    int ordered;             // Final number of ordered vertices
+} ParallelKahn;
+
+typedef struct {
+    ParallelKahn* shared;
+    int id;
+} ParallelKahnWorker;
+
+// Function to publish each thread's buffer as the next frontier.
+// Returns the size of the new frontier, or -1 if any thread failed.
+static inline int pkConcatenate(ParallelKahn* pk, int t, IntVector* buffer, int rear) {
+    pk->counts[t] = buffer->size;
+    pthread_barrier_wait(&pk->barrier);
+    if (atomic_load_explicit(&pk->failed, memory_order_relaxed)) {
+        return -1;
+    }
+
+    int offset = 0, total = 0;
+    for (int k = 0; k < pk->numThreads; k++) {
+        if (k < t) {
+            offset += pk->counts[k];
+        }
+        total += pk->counts[k];
+    }
+    for (int i = 0; i < buffer->size; i++) {
+        pk->order[rear + offset + i] = buffer->items[i];
+    }
+    buffer->size = 0;
+    pthread_barrier_wait(&pk->barrier);  // Frontier complete before anyone reads it
+    return total;
+}
+
+static inline void* pkWorker(void* arg) {
+    ParallelKahnWorker* worker = (ParallelKahnWorker*)arg;
+    ParallelKahn* pk = worker->shared;
+
+    // numThreads is only final once the gate opens
+    pthread_mutex_lock(&pk->gateLock);
+    while (pk->gate == 0) {
+        pthread_cond_wait(&pk->gateOpen, &pk->gateLock);
+    }
+    int gate = pk->gate;
+    pthread_mutex_unlock(&pk->gateLock);
+    if (gate < 0) {
+        return NULL;
+    }
+
+    const CsrGraph* graph = pk->graph;
+    int t = worker->id, numThreads = pk->numThreads;
+    int n = graph->numVertices;
+    IntVector buffer = {NULL, 0, 0};
+
+    // In-degrees, one slice of the edge array per thread
+    long long edgeLo = (long long)graph->numEdges * t / numThreads;
+    long long edgeHi = (long long)graph->numEdges * (t + 1) / numThreads;
+    for (long long e = edgeLo; e < edgeHi; e++) {
+        atomic_fetch_add_explicit(&pk->inDegree[graph->targets[e]], 1, memory_order_relaxed);
+    }
+    pthread_barrier_wait(&pk->barrier);
+
+    // First frontier: vertices with zero in-degree, one slice of vertices per thread
+    int vertexLo = (int)((long long)n * t / numThreads);
+    int vertexHi = (int)((long long)n * (t + 1) / numThreads);
+    for (int v = vertexLo; v < vertexHi; v++) {
+        if (atomic_load_explicit(&pk->inDegree[v], memory_order_relaxed) == 0 && intVectorPush(&buffer, v) != 0) {
+            atomic_store(&pk->failed, 1);
+            break;
+        }
+    }
+    int front = 0, rear = 0;
+    int total = pkConcatenate(pk, t, &buffer, rear);
+
+    while (total > 0) {
+        front = rear;
+        rear += total;
+
+        int lo = front + (int)((long long)total * t / numThreads);
+        int hi = front + (int)((long long)total * (t + 1) / numThreads);
+        for (int i = lo; i < hi; i++) {
+            int current = pk->order[i];
+            for (int e = graph->offsets[current]; e < graph->offsets[current + 1]; e++) {
+                int adjVertex = graph->targets[e];
+                // Exactly one thread sees the count drop from 1 to 0
+                if (atomic_fetch_sub_explicit(&pk->inDegree[adjVertex], 1, memory_order_relaxed) == 1 &&
+                    intVectorPush(&buffer, adjVertex) != 0) {
+                    atomic_store(&pk->failed, 1);
+                }
+            }
+        }
+        total = pkConcatenate(pk, t, &buffer, rear);
+    }
+
+    if (t == 0) {
+        pk->ordered = total < 0 ? -1 : rear;
+    }
+    free(buffer.items);
+    return NULL;
+}
+
+// Parallel Kahn's algorithm over numThreads threads.
+// Writes a topological order level by level into order and returns how many
+// vertices were ordered (fewer than numVertices means a cycle exists), or -1
+// if allocation or thread creation fails.
+static inline int csrParallelKahnOrder(const CsrGraph* graph, int numThreads, int* order) {
+    int n = graph->numVertices;
+    if (numThreads <= 1) {
+        return csrKahnOrder(graph, order);  // Barriers buy nothing on one thread
+    }
+
+    ParallelKahn pk;
+    pk.graph = graph;
+    pk.numThreads = numThreads;
+    pk.order = order;
+    pk.ordered = -1;
+    pk.inDegree = (_Atomic int*)malloc(((size_t)n + 1) * sizeof(_Atomic int));
+    pk.counts = (int*)malloc(numThreads * sizeof(int));
+    pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    ParallelKahnWorker* workers = (ParallelKahnWorker*)malloc(numThreads * sizeof(ParallelKahnWorker));
+    int result = -1;
+    if (!pk.inDegree || !pk.counts || !threads || !workers) {
+        goto cleanup;
+    }
+
+    atomic_init(&pk.failed, 0);
+    for (int v = 0; v < n; v++) {
+        atomic_init(&pk.inDegree[v], 0);
+    }
+    pthread_mutex_init(&pk.gateLock, NULL);
+    pthread_cond_init(&pk.gateOpen, NULL);
+    pk.gate = 0;
+
+    // Run with however many threads could be created; the barrier is sized
+    // to that count before any worker passes the gate
+    int started = 0;
+    for (; started < numThreads; started++) {
+        workers[started].shared = &pk;
+        workers[started].id = started;
+        if (pthread_create(&threads[started], NULL, pkWorker, &workers[started]) != 0) {
+            break;
+        }
+    }
+    pk.numThreads = started;
+    int barrierReady = started > 0 && pthread_barrier_init(&pk.barrier, NULL, started) == 0;
+    pthread_mutex_lock(&pk.gateLock);
+    pk.gate = barrierReady ? 1 : -1;
+    pthread_cond_broadcast(&pk.gateOpen);
+    pthread_mutex_unlock(&pk.gateLock);
+
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    if (barrierReady) {
+        pthread_barrier_destroy(&pk.barrier);
+        result = pk.ordered;
+    }
+    pthread_mutex_destroy(&pk.gateLock);
+    pthread_cond_destroy(&pk.gateOpen);
+
+cleanup:
+    free(pk.inDegree);
+    free(pk.counts);
+    free(threads);
+    free(workers);
+    return result;
+}
+
+#endif // KAHN_PARALLEL_H
@@ -0,0 +1,200 @@
+#ifndef MATRIX_REDUCTION_H
+#define MATRIX_REDUCTION_H
+
+#include <stdlib.h>
+
+// Deadlock detection for resources with many units each (Coffman/Shoshani).
+// A cycle only proves deadlock when every resource has a single unit; with
+// pools of units the state is given as matrices instead:
+//   Available[j]      free units of resource type j
+//   Allocation[i][j]  units of j process i holds
+//   Request[i][j]     units of j process i still waits for
+// Graph reduction repeatedly lets a process whose whole request fits in the
+// free units run to completion and release what it holds. Whatever cannot be
+// reduced is deadlocked.
+//
+// Rows are padded to a multiple of MATRIX_LANES ints and aligned, so every
+// row is a whole number of GCC vectors: comparing a request row with the
+// free units, or releasing an allocation row, is one vector operation per
+// MATRIX_LANES resource types. Create all three with matrixCreate and
+// matrixStride(numResources), and leave the padding lanes at 0.
+
+#define MATRIX_LANES 4
+
+typedef int MatrixLanes __attribute__((vector_size(MATRIX_LANES * sizeof(int))));
+
+// Number of ints per row for numResources resource types
+static inline int matrixStride(int numResources) {
+    return (numResources + MATRIX_LANES - 1) / MATRIX_LANES * MATRIX_LANES;
+}
+
+// Function to allocate a zeroed rows x stride matrix on vector boundaries,
+// NULL on failure. Release it with free.
+static inline int* matrixCreate(int rows, int stride) {
+    size_t bytes = ((size_t)rows * stride + MATRIX_LANES) * sizeof(int);
+    int* matrix = (int*)aligned_alloc(sizeof(MatrixLanes), bytes);
+    if (matrix) {
+        for (size_t k = 0; k < bytes / sizeof(int); k++) {
+            matrix[k] = 0;
+        }
+    }
+    return matrix;
+}
+
+static inline int matrixLaneSum(MatrixLanes lanes) {
+    int sum = 0;
+    for (int l = 0; l < MATRIX_LANES; l++) {
+        sum += lanes[l];
+    }
+    return sum;
+}
+
+// One waiting request: process needs more than amount - 1 units of a type
+typedef struct {
+    int amount;
+    int process;
+} MatrixWaiter;
+
+static inline int matrixWaiterCompare(const void* a, const void* b) {
+    const MatrixWaiter* x = (const MatrixWaiter*)a;
+    const MatrixWaiter* y = (const MatrixWaiter*)b;
+    if (x->amount != y->amount) {
+        return x->amount < y->amount ? -1 : 1;
+    }
+    return x->process - y->process;
+}
+
+// Function to reduce the state and find the deadlocked processes.
+// Instead of rescanning every row after each release, each process keeps a
+// count of resource types its request still exceeds, and each resource type
+// keeps its short requests sorted by amount. Free units only grow, so a
+// release advances a cursor along the sorted list of each type it touches,
+// and a process joins the worklist once its count drops to 0. Every entry is
+// visited a constant number of times beyond the initial sort.
+//
+// A process holding nothing is never part of a deadlock and counts as
+// finished from the start, as in Coffman's formulation. Unit totals must fit
+// in an int. finished[i] is set to 1 for reducible processes, and order, if
+// not NULL, receives them in completion order.
+// Returns the number of deadlocked processes, or -1 if allocation fails.
+static inline int matrixReduce(const int* available, const int* allocation, const int* request,
+                               int numProcesses, int numResources, unsigned char* finished, int* order) {
+    int n = numProcesses, m = numResources, stride = matrixStride(m), chunks = stride / MATRIX_LANES;
+    int* work = matrixCreate(1, stride);
+    int* blocked = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* queue = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* waitStart = (int*)calloc((size_t)m + 2, sizeof(int));
+    int* cursor = (int*)malloc(((size_t)m + 1) * sizeof(int));
+    MatrixWaiter* waiters = NULL;
+    int deadlocked = -1;
+    if (!work || !blocked || !queue || !waitStart || !cursor) {
+        goto cleanup;
+    }
+    for (int j = 0; j < stride; j++) {
+        work[j] = available[j];
+    }
+    MatrixLanes* workLanes = (MatrixLanes*)work;
+
+    // Count the short resource types of every row, one vector compare per chunk
+    long long totalWaiters = 0;
+    int head = 0, tail = 0, done = 0;
+    for (int i = 0; i < n; i++) {
+        const MatrixLanes* requestRow = (const MatrixLanes*)(request + (size_t)i * stride);
+        const MatrixLanes* allocationRow = (const MatrixLanes*)(allocation + (size_t)i * stride);
+        MatrixLanes shortCount = {0}, holds = {0};
+        for (int k = 0; k < chunks; k++) {
+            shortCount -= requestRow[k] > workLanes[k];  // A true lane compares as -1
+            holds |= allocationRow[k];
+        }
+        blocked[i] = matrixLaneSum(shortCount);
+        finished[i] = 0;
+        if (matrixLaneSum(holds != 0) == 0) {
+            finished[i] = 1;  // Holds nothing, so nothing can wait on it
+            if (order) {
+                order[done] = i;
+            }
+            done++;
+        } else if (blocked[i] == 0) {
+            queue[tail++] = i;
+        } else {
+            totalWaiters += blocked[i];
+        }
+    }
+
+    // Bucket the short requests by resource type, skipping chunks with none
+    waiters = (MatrixWaiter*)malloc(((size_t)totalWaiters + 1) * sizeof(MatrixWaiter));
+    if (!waiters) {
+        goto cleanup;
+    }
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < n; i++) {
+            if (finished[i] || blocked[i] == 0) {
+                continue;
+            }
+            const int* requestRow = request + (size_t)i * stride;
+            const MatrixLanes* requestLanes = (const MatrixLanes*)requestRow;
+            for (int k = 0; k < chunks; k++) {
+                if (matrixLaneSum(requestLanes[k] > workLanes[k]) == 0) {
+                    continue;
+                }
+                for (int j = k * MATRIX_LANES; j < (k + 1) * MATRIX_LANES; j++) {
+                    if (requestRow[j] > work[j]) {
+                        if (pass == 0) {
+                            waitStart[j + 2]++;
+                        } else {
+                            waiters[waitStart[j + 1]++] = (MatrixWaiter){requestRow[j], i};
+                        }
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int j = 0; j < m; j++) {
+                waitStart[j + 2] += waitStart[j + 1];
+            }
+        }
+    }
+    for (int j = 0; j < m; j++) {
+        cursor[j] = waitStart[j];
+        qsort(waiters + waitStart[j], waitStart[j + 1] - waitStart[j], sizeof(MatrixWaiter), matrixWaiterCompare);
+    }
+
+    // Worklist: finish a process, release its row, then wake the waiters it satisfies
+    while (head < tail) {
+        int i = queue[head++];
+        finished[i] = 1;
+        if (order) {
+            order[done] = i;
+        }
+        done++;
+
+        const int* allocationRow = allocation + (size_t)i * stride;
+        const MatrixLanes* allocationLanes = (const MatrixLanes*)allocationRow;
+        for (int k = 0; k < chunks; k++) {
+            if (matrixLaneSum(allocationLanes[k] != 0) == 0) {
+                continue;
+            }
+            workLanes[k] += allocationLanes[k];
+            for (int j = k * MATRIX_LANES; j < (k + 1) * MATRIX_LANES; j++) {
+                while (allocationRow[j] > 0 && cursor[j] < waitStart[j + 1] && waiters[cursor[j]].amount <= work[j]) {
+                    int p = waiters[cursor[j]++].process;
+                    if (--blocked[p] == 0) {
+                        queue[tail++] = p;
+                    }
+                }
+            }
+        }
+    }
+    deadlocked = n - done;
+
+cleanup:
+    free(work);
+    free(blocked);
+    free(queue);
+    free(waitStart);
+    free(cursor);
+    free(waiters);
+    return deadlocked;
+}
+
+#endif // MATRIX_REDUCTION_H
@@ -0,0 +1,442 @@
+#ifndef MIN_FAS_H
+#define MIN_FAS_H
+
+// Exact minimum-cost feedback arc set for small SCCs. Compile with -pthread.
+// The deadline clock is POSIX, not C11: with -std=c11 the program must define
+// _POSIX_C_SOURCE 200112L before its first include.
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "csr_graph.h"
+#include "feedback_arc_set.h"
+#include "johnson_cycles.h"
+#include "scc.h"
+
+#define MFAS_MAX_EDGES  40        // Larger SCCs keep the greedy answer
+#define MFAS_MAX_CYCLES 65536     // So do SCCs with more elementary cycles
+#define MFAS_MAX_MEMO   (1 << 22) // Subproblems remembered per SCC
+
+#define MFAS_OPTIMAL 0  // Proven minimum
+#define MFAS_BUDGET  1  // Time budget ran out; best found so far, at most the greedy cost
+#define MFAS_GREEDY  2  // Too many edges or cycles for the exact search
+
+typedef struct {
+    int firstEdge;    // Offset into MfasResult.componentEdges
+    int edgeCount;
+    int status;       // MFAS_*
+    long long cost;   // Weight removed from this component
+} MfasComponent;
+
+typedef struct {
+    int componentCount;
+    MfasComponent* components;  // Components that contain a cycle
+    int* componentEdges;        // Graph edge ids, grouped by component
+    int* edgeSource;            // Source vertex of every graph edge
+} MfasResult;
+
+static inline void mfasResultFree(MfasResult* result) {
+    free(result->components);
+    free(result->componentEdges);
+    free(result->edgeSource);
+    result->components = NULL;
+    result->componentEdges = NULL;
+    result->edgeSource = NULL;
+    result->componentCount = 0;
+}
+
+// Branch-and-bound state for one component.
+// Parallel edges between the same two vertices form one group, since a cycle
+// through them is only broken once all of them are removed. Each elementary
+// cycle is the bitmask of the groups it uses; a solution is a group mask that
+// intersects every cycle mask.
+typedef struct {
+    int groupCount;
+    long long groupWeight[64];
+    int (*groupOf)[MFAS_MAX_EDGES];  // Group of the edge between two local vertices
+    uint64_t* cycles;
+    int cycleCount;
+    int cycleCapacity;
+    int failed;
+    long long best;
+    uint64_t bestMask;
+    uint64_t* memo;     // Open-addressing set of explored masks (mask + 1, 0 empty)
+    uint32_t memoMask;
+    int memoCount;
+    long long nodes;
+    struct timespec deadline;
+    int timedOut;
+} MfasSearch;
+
+// Johnson callback: store the group mask of one cycle
+static inline int mfasCollectCycle(const int* cycle, int length, void* context) {
+    MfasSearch* search = (MfasSearch*)context;
+    if (search->cycleCount == search->cycleCapacity) {
+        int capacity = search->cycleCapacity ? 2 * search->cycleCapacity : 64;
+        uint64_t* cycles = (uint64_t*)realloc(search->cycles, capacity * sizeof(uint64_t));
+        if (!cycles) {
+            search->failed = 1;
+            return 1;
+        }
+        search->cycles = cycles;
+        search->cycleCapacity = capacity;
+    }
+    uint64_t mask = 0;
+    for (int i = 0; i < length; i++) {
+        mask |= 1ULL << search->groupOf[cycle[i]][cycle[(i + 1) % length]];
+    }
+    search->cycles[search->cycleCount++] = mask;
+    return 0;
+}
+
+// Function to double the explored-mask set. Returns 0 or -1.
+static inline int mfasMemoGrow(MfasSearch* search) {
+    uint32_t capacity = 2 * (search->memoMask + 1);
+    uint64_t* old = search->memo;
+    uint32_t oldCapacity = search->memoMask + 1;
+    search->memo = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+    if (!search->memo) {
+        search->memo = old;
+        return -1;
+    }
+    search->memoMask = capacity - 1;
+    for (uint32_t i = 0; i < oldCapacity; i++) {
+        if (old[i] != 0) {
+            uint32_t slot = (uint32_t)((old[i] * 0x9e3779b97f4a7c15ULL) >> 32) & search->memoMask;
+            while (search->memo[slot] != 0) {
+                slot = (slot + 1) & search->memoMask;
+            }
+            search->memo[slot] = old[i];
+        }
+    }
+    free(old);
+    return 0;
+}
+
+// Function to record mask as explored. Returns 1 if it already was.
+// Once the set reaches MFAS_MAX_MEMO entries it stops remembering, which
+// only costs repeated work, never correctness.
+static inline int mfasMemoSeen(MfasSearch* search, uint64_t mask) {
+    uint64_t key = mask + 1;
+    uint32_t slot = (uint32_t)((key * 0x9e3779b97f4a7c15ULL) >> 32) & search->memoMask;
+    while (search->memo[slot] != 0) {
+        if (search->memo[slot] == key) {
+            return 1;
+        }
+        slot = (slot + 1) & search->memoMask;
+    }
+    if (2 * (search->memoCount + 1) > (int)search->memoMask + 1) {
+        if (search->memoMask + 1 >= MFAS_MAX_MEMO || mfasMemoGrow(search) != 0) {
+            return 0;
+        }
+        slot = (uint32_t)((key * 0x9e3779b97f4a7c15ULL) >> 32) & search->memoMask;
+        while (search->memo[slot] != 0) {
+            slot = (slot + 1) & search->memoMask;
+        }
+    }
+    search->memo[slot] = key;
+    search->memoCount++;
+    return 0;
+}
+
+static inline int mfasPastDeadline(const MfasSearch* search) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec > search->deadline.tv_sec ||
+           (now.tv_sec == search->deadline.tv_sec && now.tv_nsec >= search->deadline.tv_nsec);
+}
+
+// Function to search all completions of the chosen group mask.
+// The remaining problem depends only on chosen, so a mask reached twice in a
+// different order is skipped. The lower bound packs pairwise disjoint unbroken
+// cycles, each of which needs at least its lightest group.
+static inline void mfasBranch(MfasSearch* search, uint64_t chosen, long long cost) {
+    if (search->timedOut) {
+        return;
+    }
+    if ((++search->nodes & 1023) == 0 && mfasPastDeadline(search)) {
+        search->timedOut = 1;
+        return;
+    }
+    if (mfasMemoSeen(search, chosen)) {
+        return;
+    }
+
+    long long bound = 0;
+    uint64_t packed = 0;
+    int branchCycle = -1, branchSize = 65;
+    for (int c = 0; c < search->cycleCount; c++) {
+        uint64_t mask = search->cycles[c];
+        if (mask & chosen) {
+            continue;
+        }
+        int size = __builtin_popcountll(mask);
+        if (size < branchSize) {
+            branchSize = size;
+            branchCycle = c;
+        }
+        if ((mask & packed) == 0) {
+            long long lightest = -1;
+            for (uint64_t bits = mask; bits; bits &= bits - 1) {
+                long long weight = search->groupWeight[__builtin_ctzll(bits)];
+                if (lightest < 0 || weight < lightest) {
+                    lightest = weight;
+                }
+            }
+            bound += lightest;
+            packed |= mask;
+        }
+    }
+
+    if (branchCycle == -1) {
+        if (cost < search->best) {
+            search->best = cost;
+            search->bestMask = chosen;
+        }
+        return;
+    }
+    if (cost + bound >= search->best) {
+        return;
+    }
+
+    // The smallest unbroken cycle must lose one of its groups
+    for (uint64_t bits = search->cycles[branchCycle]; bits; bits &= bits - 1) {
+        int group = __builtin_ctzll(bits);
+        mfasBranch(search, chosen | (1ULL << group), cost + search->groupWeight[group]);
+    }
+}
+
+// Function to solve one component exactly, starting from the greedy flags
+// already in removed (whose weight comp->cost holds) and overwriting them
+// only with a cheaper answer
+static inline void mfasSolveComponent(const CsrGraph* graph, MfasComponent* comp, const int* edges,
+                                      const int* edgeSource, unsigned char* removed, int budgetMs) {
+    int k = comp->edgeCount;
+    int vertices[MFAS_MAX_EDGES], edgeGroup[MFAS_MAX_EDGES];
+    int local[MFAS_MAX_EDGES][2];
+    int vertexCount = 0;
+
+    comp->status = MFAS_GREEDY;
+    if (k > MFAS_MAX_EDGES) {
+        return;
+    }
+
+    // Relabel the component's vertices 0..vertexCount-1
+    for (int i = 0; i < k; i++) {
+        int ends[2] = {edgeSource[edges[i]], graph->targets[edges[i]]};
+        for (int j = 0; j < 2; j++) {
+            int id = 0;
+            while (id < vertexCount && vertices[id] != ends[j]) {
+                id++;
+            }
+            if (id == vertexCount) {
+                vertices[vertexCount++] = ends[j];
+            }
+            local[i][j] = id;
+        }
+    }
+
+    MfasSearch search = {0};
+    search.groupOf = (int (*)[MFAS_MAX_EDGES])malloc(sizeof(int[MFAS_MAX_EDGES][MFAS_MAX_EDGES]));
+    int srcList[MFAS_MAX_EDGES], destList[MFAS_MAX_EDGES];
+    if (!search.groupOf) {
+        return;
+    }
+    for (int a = 0; a < vertexCount; a++) {
+        for (int b = 0; b < vertexCount; b++) {
+            search.groupOf[a][b] = -1;
+        }
+    }
+    uint64_t greedyMask = 0;
+    for (int i = 0; i < k; i++) {
+        int a = local[i][0], b = local[i][1];
+        if (search.groupOf[a][b] == -1) {
+            srcList[search.groupCount] = a;
+            destList[search.groupCount] = b;
+            search.groupOf[a][b] = search.groupCount++;
+        }
+        edgeGroup[i] = search.groupOf[a][b];
+        int weight = graph->weights ? graph->weights[edges[i]] : 1;
+        search.groupWeight[edgeGroup[i]] += weight;
+        if (removed[edges[i]]) {
+            greedyMask |= 1ULL << edgeGroup[i];
+        }
+    }
+
+    // Cycle-group incidence, via Johnson on the component's own graph
+    CsrGraph localGraph;
+    CycleLimits limits = {MFAS_MAX_CYCLES + 1, 0};
+    long long cycleCount = -1;
+    if (csrBuild(&localGraph, vertexCount, search.groupCount, srcList, destList, NULL) == 0) {
+        cycleCount = johnsonEnumerate(&localGraph, &limits, mfasCollectCycle, &search);
+        csrFree(&localGraph);
+    }
+    search.memo = (uint64_t*)calloc(1024, sizeof(uint64_t));
+    if (cycleCount < 0 || cycleCount > MFAS_MAX_CYCLES || search.failed || !search.memo) {
+        free(search.groupOf);
+        free(search.cycles);
+        free(search.memo);
+        return;
+    }
+    search.memoMask = 1023;
+
+    // Branch and bound, with the greedy answer as the first upper bound
+    search.best = comp->cost;
+    search.bestMask = greedyMask;
+    clock_gettime(CLOCK_MONOTONIC, &search.deadline);
+    search.deadline.tv_sec += budgetMs / 1000;
+    search.deadline.tv_nsec += (long)(budgetMs % 1000) * 1000000L;
+    if (search.deadline.tv_nsec >= 1000000000L) {
+        search.deadline.tv_sec++;
+        search.deadline.tv_nsec -= 1000000000L;
+    }
+    mfasBranch(&search, 0, 0);
+
+    comp->status = search.timedOut ? MFAS_BUDGET : MFAS_OPTIMAL;
+    comp->cost = search.best;
+    for (int i = 0; i < k; i++) {
+        removed[edges[i]] = (search.bestMask >> edgeGroup[i]) & 1;
+    }
+
+    free(search.groupOf);
+    free(search.cycles);
+    free(search.memo);
+}
+
+// Shared work queue of the solver threads
+typedef struct {
+    const CsrGraph* graph;
+    MfasResult* result;
+    unsigned char* removed;
+    int budgetMs;
+    _Atomic int next;
+} MfasPool;
+
+static inline void* mfasWorker(void* arg) {
+    MfasPool* pool = (MfasPool*)arg;
+    MfasResult* result = pool->result;
+    for (;;) {
+        int c = atomic_fetch_add(&pool->next, 1);
+        if (c >= result->componentCount) {
+            break;
+        }
+        MfasComponent* comp = &result->components[c];
+        mfasSolveComponent(pool->graph, comp, result->componentEdges + comp->firstEdge,
+                           result->edgeSource, pool->removed, pool->budgetMs);
+    }
+    return NULL;
+}
+
+// Function to compute a minimum-cost feedback arc set.
+// The greedy Eades-Lin-Smyth set is computed first for the whole graph; then
+// every cyclic SCC with at most MFAS_MAX_EDGES edges is handed to a pool of
+// numThreads threads that replace its greedy edges with an exact optimum,
+// each SCC getting budgetMs milliseconds. SCCs touch disjoint edges, so the
+// threads write removed[] without locking.
+//
+// Sets removed[e] for the chosen edges and fills result with one entry per
+// cyclic SCC. Returns the total weight removed, or -1 if allocation fails.
+static inline long long csrMinFeedbackArcSet(const CsrGraph* graph, int numThreads, int budgetMs,
+                                             unsigned char* removed, MfasResult* result) {
+    int n = graph->numVertices, m = graph->numEdges;
+    result->componentCount = 0;
+    result->components = NULL;
+    result->componentEdges = (int*)malloc(((size_t)m + 1) * sizeof(int));
+    result->edgeSource = (int*)malloc(((size_t)m + 1) * sizeof(int));
+    int* sccId = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* edgeStart = (int*)calloc((size_t)n + 2, sizeof(int));
+    SccWorkspace ws;
+    int wsReady = sccWorkspaceInit(&ws, n) == 0;
+    long long total = -1;
+    if (!result->componentEdges || !result->edgeSource || !sccId || !edgeStart || !wsReady ||
+        csrFeedbackArcSet(graph, removed) < 0) {
+        goto cleanup;
+    }
+
+    // Group intra-SCC edges by component with a counting sort
+    int components = sccCompute(graph, 0, sccId, &ws);
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            result->edgeSource[e] = u;
+            if (sccId[graph->targets[e]] == sccId[u]) {
+                edgeStart[sccId[u] + 2]++;
+            }
+        }
+    }
+    for (int c = 0; c < components; c++) {
+        edgeStart[c + 2] += edgeStart[c + 1];
+    }
+    for (int u = 0; u < n; u++) {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            if (sccId[graph->targets[e]] == sccId[u]) {
+                result->componentEdges[edgeStart[sccId[u] + 1]++] = e;
+            }
+        }
+    }
+
+    result->components = (MfasComponent*)malloc(((size_t)components + 1) * sizeof(MfasComponent));
+    if (!result->components) {
+        goto cleanup;
+    }
+    for (int c = 0; c < components; c++) {
+        int count = edgeStart[c + 1] - edgeStart[c];
+        if (count == 0) {
+            continue;  // A single vertex without a self-loop
+        }
+        MfasComponent* comp = &result->components[result->componentCount++];
+        comp->firstEdge = edgeStart[c];
+        comp->edgeCount = count;
+        comp->status = MFAS_GREEDY;
+        comp->cost = 0;
+        for (int i = 0; i < count; i++) {
+            int e = result->componentEdges[edgeStart[c] + i];
+            if (removed[e]) {
+                comp->cost += graph->weights ? graph->weights[e] : 1;
+            }
+        }
+    }
+
+    // Solve the components on a pool of threads; this thread is one of them
+    MfasPool pool;
+    pool.graph = graph;
+    pool.result = result;
+    pool.removed = removed;
+    pool.budgetMs = budgetMs;
+    atomic_init(&pool.next, 0);
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    int started = 0;
+    while (threads && started < numThreads - 1 && pthread_create(&threads[started], NULL, mfasWorker, &pool) == 0) {
+        started++;
+    }
+    mfasWorker(&pool);
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+
+    total = 0;
+    for (int e = 0; e < m; e++) {
+        if (removed[e]) {
+            total += graph->weights ? graph->weights[e] : 1;
+        }
+    }
+
+cleanup:
+    if (wsReady) {
+        sccWorkspaceFree(&ws);
+    }
+    free(sccId);
+    free(edgeStart);
+    if (total < 0) {
+        mfasResultFree(result);
+    }
+    return total;
+}
+
+#endif // MIN_FAS_H
@@ -0,0 +1,375 @@
+#ifndef PARALLEL_DFS_H
+#define PARALLEL_DFS_H
+
+// Multithreaded cycle detection. Compile with -pthread.
+//
+// Work is handed out as DFS roots. Each thread owns a range of root vertices
+// and an idle thread takes half of another thread's remaining roots. A running
+// DFS is never split, because its frame stack must stay one path for a back
+// edge into it to mean a cycle. A search that reaches a vertex on another
+// stack cannot go on until that vertex is done, so instead of waiting the
+// thread sets the search aside, with its vertices still claimed, and starts
+// another root. It picks the search back up once the vertex is done. Only a
+// thread whose searches are all set aside, with no roots left to take, waits.
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "dfs_cycle.h"
+
+#define PAR_UNVISITED 0   // Vertex state: not claimed yet
+#define PAR_DONE     -1   // Vertex state: fully explored, no cycle through it
+                          // Any other value s + 1: on search stack s
+#define PAR_STACKS    4   // Searches one thread holds at once; stack s belongs to thread s / PAR_STACKS
+
+// Shared state of one parallel detection run.
+// Each thread owns a range of root vertices [lo, hi) packed into one 64-bit
+// word (lo in the high half) so owner pops and thief splits are single CASes.
+typedef struct {
+    const CsrGraph* graph;
+    int numThreads;
+    int numStacks;               // numThreads * PAR_STACKS
+    _Atomic int* owner;          // Per-vertex state, see PAR_* above
+    _Atomic uint64_t* roots;     // Per-thread root range
+    _Atomic int* waitingOn;      // Vertex a stack is set aside on, -1 if running or free
+    _Atomic unsigned* waitEpoch; // Bumped whenever a stack is set aside or picked back up
+    _Atomic int stop;            // Set once any thread confirms a cycle
+    _Atomic int witness;         // A vertex on the confirmed cycle
+    _Atomic int failed;          // Set if a thread could not grow its stack
+} ParallelDfs;
+
+typedef struct {
+    ParallelDfs* shared;
+    int id;
+} ParallelDfsWorker;
+
+// One search of a thread, private to it
+typedef struct {
+    DfsFrame* frames;
+    int capacity;
+    int top;          // -1 while the slot is free
+    int waitedState;  // Owner value of the vertex it was set aside on
+} ParallelDfsStack;
+
+static inline uint64_t parPackRange(uint32_t lo, uint32_t hi) {
+    return ((uint64_t)lo << 32) | hi;
+}
+
+// Function to take the next root from a thread's own range, -1 if empty
+static inline int parPopRoot(ParallelDfs* par, int t) {
+    uint64_t range = atomic_load(&par->roots[t]);
+    for (;;) {
+        uint32_t lo = (uint32_t)(range >> 32), hi = (uint32_t)range;
+        if (lo >= hi) {
+            return -1;
+        }
+        if (atomic_compare_exchange_weak(&par->roots[t], &range, parPackRange(lo + 1, hi))) {
+            return (int)lo;
+        }
+    }
+}
+
+// Function to take the upper half of another thread's unclaimed roots into our own range
+static inline int parStealRoots(ParallelDfs* par, int t) {
+    for (int k = 1; k < par->numThreads; k++) {
+        int victim = (t + k) % par->numThreads;
+        uint64_t range = atomic_load(&par->roots[victim]);
+        for (;;) {
+            uint32_t lo = (uint32_t)(range >> 32), hi = (uint32_t)range;
+            if (lo >= hi) {
+                break;
+            }
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (atomic_compare_exchange_weak(&par->roots[victim], &range, parPackRange(lo, mid))) {
+                atomic_store(&par->roots[t], parPackRange(mid, hi));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+// Function to walk the chain of stacks set aside on each other's vertices.
+// If stack s waits on a vertex of stack a, a on one of b, ... and the last
+// waits on a vertex of s, those stack segments and waited-on edges form a
+// graph cycle. The chain is read twice and only trusted if no stack in it
+// changed its wait in between (each was set aside, so frozen, for the whole
+// interval). Returns 1 if a cycle is confirmed.
+static inline int parChainClosesCycle(ParallelDfs* par, int s, int* chainStacks, unsigned* chainEpochs, int* chainWaits) {
+    int length = 0;
+    int current = s;
+    for (;;) {
+        if (length == par->numStacks) {
+            return 0;
+        }
+        unsigned epoch = atomic_load(&par->waitEpoch[current]);
+        int waited = atomic_load(&par->waitingOn[current]);
+        if (waited < 0) {
+            return 0;  // This stack is running, the chain will make progress
+        }
+        chainStacks[length] = current;
+        chainEpochs[length] = epoch;
+        chainWaits[length] = waited;
+        length++;
+
+        int state = atomic_load(&par->owner[waited]);
+        if (state <= 0) {
+            return 0;  // Finished meanwhile
+        }
+        current = state - 1;
+        if (current == s) {
+            break;
+        }
+        for (int i = 0; i < length; i++) {
+            if (chainStacks[i] == current) {
+                return 0;  // A loop that does not include us, its owners will see it
+            }
+        }
+    }
+
+    // Second collect: nothing in the chain may have moved
+    for (int i = 0; i < length; i++) {
+        int next = (i + 1 < length) ? chainStacks[i + 1] : s;
+        if (atomic_load(&par->waitingOn[chainStacks[i]]) != chainWaits[i] ||
+            atomic_load(&par->waitEpoch[chainStacks[i]]) != chainEpochs[i] ||
+            atomic_load(&par->owner[chainWaits[i]]) != next + 1) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Function to signal every thread to stop because a cycle through vertex was found
+static inline void parReportCycle(ParallelDfs* par, int vertex) {
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&par->stop, &expected, 1)) {
+        atomic_store(&par->witness, vertex);
+    }
+}
+
+// Function to run search stack s until it finishes, the run stops, or it
+// reaches a vertex on another stack. In that last case the stack is set
+// aside on the vertex and 1 is returned; otherwise 0.
+static inline int parRunStack(ParallelDfs* par, int s, ParallelDfsStack* st) {
+    const CsrGraph* graph = par->graph;
+    int mine = s + 1;
+
+    while (st->top >= 0 && !atomic_load_explicit(&par->stop, memory_order_relaxed)) {
+        DfsFrame* frame = &st->frames[st->top];
+        int v = frame->vertex;
+
+        if (frame->cursor == graph->offsets[v + 1]) {
+            // Every successor is done, so no cycle passes through v
+            atomic_store_explicit(&par->owner[v], PAR_DONE, memory_order_release);
+            st->top--;
+            continue;
+        }
+
+        int w = graph->targets[frame->cursor];
+        int state = atomic_load_explicit(&par->owner[w], memory_order_acquire);
+
+        if (state == PAR_DONE) {
+            frame->cursor++;
+        } else if (state == PAR_UNVISITED) {
+            if (!atomic_compare_exchange_strong(&par->owner[w], &state, mine)) {
+                continue;  // Lost the race, look at w's new state
+            }
+            frame->cursor++;
+            if (st->top + 1 == st->capacity) {
+                DfsFrame* grown = (DfsFrame*)realloc(st->frames, 2 * st->capacity * sizeof(DfsFrame));
+                if (!grown) {
+                    atomic_store(&par->failed, 1);
+                    atomic_store(&par->stop, 1);
+                    return 0;
+                }
+                st->frames = grown;
+                st->capacity *= 2;
+            }
+            st->top++;
+            st->frames[st->top].vertex = w;
+            st->frames[st->top].cursor = graph->offsets[w];
+        } else if (state == mine) {
+            parReportCycle(par, w);  // Back edge into our own stack
+        } else {
+            // w is on another stack, perhaps one of ours set aside earlier.
+            // The cursor stays on w, so w is looked at again on resuming.
+            st->waitedState = state;
+            atomic_store(&par->waitingOn[s], w);
+            atomic_fetch_add(&par->waitEpoch[s], 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Worker: runs up to PAR_STACKS searches, one at a time. It resumes a search
+// whose waited-on vertex is done, else starts one from a root (own range
+// first, then taken ones), and only when neither is possible looks for a
+// ring of waiting stacks through its own and yields.
+static inline void* parDfsWorker(void* arg) {
+    ParallelDfsWorker* worker = (ParallelDfsWorker*)arg;
+    ParallelDfs* par = worker->shared;
+    const CsrGraph* graph = par->graph;
+    int t = worker->id;
+    int base = t * PAR_STACKS;
+
+    ParallelDfsStack stacks[PAR_STACKS];
+    for (int k = 0; k < PAR_STACKS; k++) {
+        stacks[k] = (ParallelDfsStack){NULL, 0, -1, 0};
+    }
+    int* chainStacks = (int*)malloc(par->numStacks * sizeof(int));
+    unsigned* chainEpochs = (unsigned*)malloc(par->numStacks * sizeof(unsigned));
+    int* chainWaits = (int*)malloc(par->numStacks * sizeof(int));
+    if (!chainStacks || !chainEpochs || !chainWaits) {
+        atomic_store(&par->failed, 1);
+        atomic_store(&par->stop, 1);
+        goto done;
+    }
+
+    while (!atomic_load_explicit(&par->stop, memory_order_relaxed)) {
+        int run = -1, idle = -1, waiting = 0;
+        for (int k = 0; k < PAR_STACKS && run == -1; k++) {
+            if (stacks[k].top < 0) {
+                idle = (idle == -1) ? k : idle;
+            } else if (atomic_load(&par->owner[atomic_load(&par->waitingOn[base + k])]) != stacks[k].waitedState) {
+                // The vertex it waited on is done: pick the search back up
+                atomic_store(&par->waitingOn[base + k], -1);
+                atomic_fetch_add(&par->waitEpoch[base + k], 1);
+                run = k;
+            } else {
+                waiting++;
+            }
+        }
+
+        if (run == -1 && idle != -1) {
+            int root = parPopRoot(par, t);
+            if (root == -1 && parStealRoots(par, t)) {
+                root = parPopRoot(par, t);
+            }
+            if (root != -1) {
+                int expected = PAR_UNVISITED;
+                if (!atomic_compare_exchange_strong(&par->owner[root], &expected, base + idle + 1)) {
+                    continue;  // Claimed by a DFS that got there first
+                }
+                ParallelDfsStack* st = &stacks[idle];
+                if (!st->frames) {
+                    st->capacity = 256;
+                    st->frames = (DfsFrame*)malloc(st->capacity * sizeof(DfsFrame));
+                    if (!st->frames) {
+                        atomic_store(&par->failed, 1);
+                        atomic_store(&par->stop, 1);
+                        break;
+                    }
+                }
+                st->top = 0;
+                st->frames[0].vertex = root;
+                st->frames[0].cursor = graph->offsets[root];
+                run = idle;
+            }
+        }
+
+        if (run == -1) {
+            if (waiting == 0) {
+                break;  // No roots left and nothing set aside
+            }
+            // Every search here waits: a ring of waiting stacks is a cycle
+            for (int k = 0; k < PAR_STACKS; k++) {
+                if (stacks[k].top >= 0 && parChainClosesCycle(par, base + k, chainStacks, chainEpochs, chainWaits)) {
+                    parReportCycle(par, atomic_load(&par->waitingOn[base + k]));
+                    break;
+                }
+            }
+            sched_yield();
+            continue;
+        }
+
+        parRunStack(par, base + run, &stacks[run]);
+    }
+
+done:
+    for (int k = 0; k < PAR_STACKS; k++) {
+        free(stacks[k].frames);
+    }
+    free(chainStacks);
+    free(chainEpochs);
+    free(chainWaits);
+    return NULL;
+}
+
+// Function to detect a cycle with numThreads threads exploring from many roots
+// at once. Returns 1 if a cycle exists (witness receives a vertex on one),
+// 0 if the graph is acyclic, -1 if allocation or thread creation fails.
+static inline int parallelDetectCycle(const CsrGraph* graph, int numThreads, int* witness) {
+    int n = graph->numVertices;
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+
+    ParallelDfs par;
+    par.graph = graph;
+    par.numThreads = numThreads;
+    par.numStacks = numThreads * PAR_STACKS;
+    par.owner = (_Atomic int*)malloc(((size_t)n + 1) * sizeof(_Atomic int));
+    par.roots = (_Atomic uint64_t*)malloc(numThreads * sizeof(_Atomic uint64_t));
+    par.waitingOn = (_Atomic int*)malloc(par.numStacks * sizeof(_Atomic int));
+    par.waitEpoch = (_Atomic unsigned*)malloc(par.numStacks * sizeof(_Atomic unsigned));
+    pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    ParallelDfsWorker* workers = (ParallelDfsWorker*)malloc(numThreads * sizeof(ParallelDfsWorker));
+    int result = -1;
+    if (!par.owner || !par.roots || !par.waitingOn || !par.waitEpoch || !threads || !workers) {
+        goto cleanup;
+    }
+
+    atomic_init(&par.stop, 0);
+    atomic_init(&par.witness, -1);
+    atomic_init(&par.failed, 0);
+    for (int v = 0; v < n; v++) {
+        atomic_init(&par.owner[v], PAR_UNVISITED);
+    }
+    // Contiguous initial root ranges, rebalanced later by parStealRoots
+    for (int t = 0; t < numThreads; t++) {
+        uint32_t lo = (uint32_t)((long long)n * t / numThreads);
+        uint32_t hi = (uint32_t)((long long)n * (t + 1) / numThreads);
+        atomic_init(&par.roots[t], parPackRange(lo, hi));
+    }
+    for (int s = 0; s < par.numStacks; s++) {
+        atomic_init(&par.waitingOn[s], -1);
+        atomic_init(&par.waitEpoch[s], 0);
+    }
+
+    int started = 0;
+    for (; started < numThreads; started++) {
+        workers[started].shared = &par;
+        workers[started].id = started;
+        if (pthread_create(&threads[started], NULL, parDfsWorker, &workers[started]) != 0) {
+            atomic_store(&par.failed, 1);
+            atomic_store(&par.stop, 1);
+            break;
+        }
+    }
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    if (atomic_load(&par.witness) != -1) {
+        *witness = atomic_load(&par.witness);
+        result = 1;
+    } else if (!atomic_load(&par.failed)) {
+        result = 0;
+    }
+
+cleanup:
+    free(par.owner);
+    free(par.roots);
+    free(par.waitingOn);
+    free(par.waitEpoch);
+    free(threads);
+    free(workers);
+    return result;
+}
+
+#endif // PARALLEL_DFS_H
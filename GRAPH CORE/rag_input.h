@@ -0,0 +1,69 @@
+#ifndef RAG_INPUT_H
+#define RAG_INPUT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "intern_table.h"
+
+// Reader for the resource allocation graph input of the Tarjan-style tools:
+// the process, resource and edge counts, the process names, the resource
+// names, then one "source destination" pair per edge. A name first seen on an
+// edge becomes a node too, so the graph is sized only once every edge is in.
+
+// Function to read a graph from stdin into names, which this initializes,
+// and graph. processCount, if not NULL, receives the number of distinct
+// process names; they are nodes 0 .. processCount - 1. Returns 0 on success,
+// or -1 if allocation fails, in which case names and graph are left freed.
+static inline int ragRead(InternTable* names, CsrGraph* graph, int* processCount) {
+    int numProcesses, numResources, numEdges;
+    char name[MAX_NAME_LENGTH], source[MAX_NAME_LENGTH], destination[MAX_NAME_LENGTH];
+    *graph = (CsrGraph){0};
+
+    printf("Enter number of processes, resources, and edges: ");
+    scanf("%d %d %d", &numProcesses, &numResources, &numEdges);
+
+    if (internInit(names, numProcesses + numResources) != 0) {
+        return -1;
+    }
+
+    // Processes and resources input
+    int failed = 0;
+    printf("Enter process names: ");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        failed |= internAdd(names, name) == -1;
+    }
+    if (processCount) {
+        *processCount = names->count;
+    }
+
+    printf("Enter resource names: ");
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        failed |= internAdd(names, name) == -1;
+    }
+
+    // Edges input
+    printf("Enter edges (source destination):\n");
+    int* srcList = (int*)malloc(((size_t)numEdges + 1) * sizeof(int));
+    int* destList = (int*)malloc(((size_t)numEdges + 1) * sizeof(int));
+    failed |= !srcList || !destList;
+    for (int i = 0; i < numEdges && !failed; i++) {
+        scanf("%63s %63s", source, destination);
+        srcList[i] = internAdd(names, source);
+        destList[i] = internAdd(names, destination);
+        failed |= srcList[i] == -1 || destList[i] == -1;
+    }
+
+    if (failed || csrBuild(graph, names->count, numEdges, srcList, destList, NULL) != 0) {
+        internFree(names);
+        failed = 1;
+    }
+    free(srcList);
+    free(destList);
+    return failed ? -1 : 0;
+}
+
+#endif // RAG_INPUT_H
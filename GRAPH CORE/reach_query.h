@@ -0,0 +1,117 @@
+#ifndef REACH_QUERY_H
+#define REACH_QUERY_H
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "csr_graph.h"
+
+// Point reachability for admission checks: a candidate edge u -> v closes a
+// cycle exactly when v already reaches u. A bidirectional BFS grows a forward
+// frontier from v and a backward frontier from u over the transpose, always
+// expanding the smaller one a whole level at a time, and stops as soon as
+// they touch. The cost depends on the neighborhoods around u and v rather
+// than on the size of the graph.
+//
+// Nothing is cleared between queries. One stamp per vertex records the side
+// that reached it: 2 * epoch forward, 2 * epoch + 1 backward, and any older
+// value means unseen. Each vertex is queued at most once per query, so both
+// queues share one array of numVertices ints, growing from opposite ends.
+
+#define REACH_BUDGET_EXCEEDED (-2)
+
+typedef struct {
+    const CsrGraph* graph;
+    CsrGraph reverse;
+    int* stamp;
+    int* queue;
+    int epoch;
+    long long edgesScanned;  // Over the last query
+} ReachQuery;
+
+static inline void reachQueryFree(ReachQuery* query) {
+    csrFree(&query->reverse);
+    free(query->stamp);
+    free(query->queue);
+    query->stamp = query->queue = NULL;
+}
+
+// Function to prepare queries over graph, which must outlive them.
+// Returns 0 on success, -1 if allocation fails.
+static inline int reachQueryInit(ReachQuery* query, const CsrGraph* graph) {
+    int n = graph->numVertices;
+    query->graph = graph;
+    query->epoch = 0;
+    query->edgesScanned = 0;
+    query->reverse = (CsrGraph){0};
+    query->stamp = (int*)calloc((size_t)n + 1, sizeof(int));
+    query->queue = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    if (!query->stamp || !query->queue || csrTranspose(graph, &query->reverse) != 0) {
+        reachQueryFree(query);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to check whether from reaches to, scanning at most budget edges
+// (budget <= 0 means no limit). Returns 1 if it does, 0 if not, or
+// REACH_BUDGET_EXCEEDED if the budget ran out first.
+static inline int reachQueryRun(ReachQuery* query, int from, int to, long long budget) {
+    query->edgesScanned = 0;
+    if (from == to) {
+        return 1;
+    }
+    if (query->epoch >= INT_MAX / 2 - 1) {
+        for (int v = 0; v < query->graph->numVertices; v++) {
+            query->stamp[v] = 0;
+        }
+        query->epoch = 0;
+    }
+    query->epoch++;
+
+    int forwardMark = 2 * query->epoch, backwardMark = forwardMark + 1;
+    int* stamp = query->stamp;
+    int* queue = query->queue;
+    int n = query->graph->numVertices;
+
+    // Forward queue is queue[forwardHead .. forwardTail), backward queue is
+    // queue[backwardTail + 1 .. backwardHead], read downwards
+    int forwardHead = 0, forwardTail = 1, backwardHead = n - 1, backwardTail = n - 2;
+    queue[0] = from;
+    queue[n - 1] = to;
+    stamp[from] = forwardMark;
+    stamp[to] = backwardMark;
+
+    while (forwardHead < forwardTail && backwardHead > backwardTail) {
+        int forward = forwardTail - forwardHead <= backwardHead - backwardTail;
+        const CsrGraph* side = forward ? query->graph : &query->reverse;
+        int ownMark = forward ? forwardMark : backwardMark;
+        int otherMark = forward ? backwardMark : forwardMark;
+        int levelEnd = forward ? forwardTail : backwardTail;
+
+        while (forward ? forwardHead < levelEnd : backwardHead > levelEnd) {
+            int u = forward ? queue[forwardHead++] : queue[backwardHead--];
+            for (int e = side->offsets[u]; e < side->offsets[u + 1]; e++) {
+                if (budget > 0 && query->edgesScanned == budget) {
+                    return REACH_BUDGET_EXCEEDED;
+                }
+                query->edgesScanned++;
+                int w = side->targets[e];
+                if (stamp[w] == otherMark) {
+                    return 1;
+                }
+                if (stamp[w] != ownMark) {
+                    stamp[w] = ownMark;
+                    if (forward) {
+                        queue[forwardTail++] = w;
+                    } else {
+                        queue[backwardTail--] = w;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+#endif // REACH_QUERY_H
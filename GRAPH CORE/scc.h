@@ -0,0 +1,199 @@
+#ifndef SCC_H
+#define SCC_H
+
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "dfs_cycle.h"
+
+// Scratch arrays for strongly connected components, sized once for a graph
+// and reused across calls so repeated decompositions do not allocate.
+typedef struct {
+    int capacity;
+    int* index;        // DFS discovery index, -1 when unvisited
+    int* low;          // Low-link values
+    int* stack;        // Tarjan's component stack
+    char* onStack;
+    DfsFrame* frames;  // Explicit DFS stack, replaces recursion
+} SccWorkspace;
+
+static inline void sccWorkspaceFree(SccWorkspace* ws) {
+    free(ws->index);
+    free(ws->low);
+    free(ws->stack);
+    free(ws->onStack);
+    free(ws->frames);
+    ws->index = ws->low = ws->stack = NULL;
+    ws->onStack = NULL;
+    ws->frames = NULL;
+    ws->capacity = 0;
+}
+
+// Function to allocate scratch space for graphs of up to numVertices vertices.
+// Returns 0 on success, -1 if allocation fails.
+static inline int sccWorkspaceInit(SccWorkspace* ws, int numVertices) {
+    size_t n = (size_t)numVertices + 1;
+    ws->capacity = numVertices;
+    ws->index = (int*)malloc(n * sizeof(int));
+    ws->low = (int*)malloc(n * sizeof(int));
+    ws->stack = (int*)malloc(n * sizeof(int));
+    ws->onStack = (char*)malloc(n * sizeof(char));
+    ws->frames = (DfsFrame*)malloc(n * sizeof(DfsFrame));
+    if (!ws->index || !ws->low || !ws->stack || !ws->onStack || !ws->frames) {
+        sccWorkspaceFree(ws);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to label the SCCs of the subgraph induced by vertices >= minVertex
+// with an iterative Tarjan DFS. sccId[v] receives a component number for every
+// vertex >= minVertex and -1 below it. Components are numbered in the order
+// Tarjan completes them, which is a reverse topological order of the
+// condensation. Returns the number of components.
+static inline int sccCompute(const CsrGraph* graph, int minVertex, int* sccId, SccWorkspace* ws) {
+    int n = graph->numVertices;
+    int counter = 0, stackTop = 0, components = 0;
+
+    for (int v = 0; v < n; v++) {
+        ws->index[v] = -1;
+        ws->onStack[v] = 0;
+        sccId[v] = -1;
+    }
+
+    for (int root = minVertex; root < n; root++) {
+        if (ws->index[root] != -1) {
+            continue;
+        }
+
+        int top = 0;
+        ws->frames[0].vertex = root;
+        ws->frames[0].cursor = graph->offsets[root];
+        ws->index[root] = ws->low[root] = counter++;
+        ws->stack[stackTop++] = root;
+        ws->onStack[root] = 1;
+
+        while (top >= 0) {
+            DfsFrame* frame = &ws->frames[top];
+            int u = frame->vertex;
+
+            if (frame->cursor < graph->offsets[u + 1]) {
+                int v = graph->targets[frame->cursor++];
+                if (v < minVertex) {
+                    continue;
+                }
+                if (ws->index[v] == -1) {
+                    ws->index[v] = ws->low[v] = counter++;
+                    ws->stack[stackTop++] = v;
+                    ws->onStack[v] = 1;
+                    top++;
+                    ws->frames[top].vertex = v;
+                    ws->frames[top].cursor = graph->offsets[v];
+                } else if (ws->onStack[v] && ws->index[v] < ws->low[u]) {
+                    ws->low[u] = ws->index[v];
+                }
+                continue;
+            }
+
+            // u is finished: pop its component if it is a root
+            if (ws->low[u] == ws->index[u]) {
+                int w;
+                do {
+                    w = ws->stack[--stackTop];
+                    ws->onStack[w] = 0;
+                    sccId[w] = components;
+                } while (w != u);
+                components++;
+            }
+            top--;
+            if (top >= 0) {
+                int parent = ws->frames[top].vertex;
+                if (ws->low[u] < ws->low[parent]) {
+                    ws->low[parent] = ws->low[u];
+                }
+            }
+        }
+    }
+
+    return components;
+}
+
+// Function to re-split one existing component after some of its edges were
+// removed. members lists the component's vertices, all sharing one sccId;
+// only edges that are not removed and stay inside that component are
+// followed, so the rest of the graph is never touched. The members receive
+// fresh ids nextId, nextId + 1, ... in reverse topological order.
+// Returns the number of components the old one split into.
+static inline int sccComputeWithin(const CsrGraph* graph, const int* members, int count,
+                                   const unsigned char* removed, int* sccId, int nextId, SccWorkspace* ws) {
+    if (count == 0) {
+        return 0;
+    }
+    int label = sccId[members[0]];
+    int counter = 0, stackTop = 0, components = 0;
+
+    for (int i = 0; i < count; i++) {
+        ws->index[members[i]] = -1;
+        ws->onStack[members[i]] = 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int root = members[i];
+        if (ws->index[root] != -1) {
+            continue;
+        }
+
+        int top = 0;
+        ws->frames[0].vertex = root;
+        ws->frames[0].cursor = graph->offsets[root];
+        ws->index[root] = ws->low[root] = counter++;
+        ws->stack[stackTop++] = root;
+        ws->onStack[root] = 1;
+
+        while (top >= 0) {
+            DfsFrame* frame = &ws->frames[top];
+            int u = frame->vertex;
+
+            if (frame->cursor < graph->offsets[u + 1]) {
+                int e = frame->cursor++;
+                int v = graph->targets[e];
+                // Relabelled members are finished components and can be skipped too
+                if (removed[e] || sccId[v] != label) {
+                    continue;
+                }
+                if (ws->index[v] == -1) {
+                    ws->index[v] = ws->low[v] = counter++;
+                    ws->stack[stackTop++] = v;
+                    ws->onStack[v] = 1;
+                    top++;
+                    ws->frames[top].vertex = v;
+                    ws->frames[top].cursor = graph->offsets[v];
+                } else if (ws->onStack[v] && ws->index[v] < ws->low[u]) {
+                    ws->low[u] = ws->index[v];
+                }
+                continue;
+            }
+
+            if (ws->low[u] == ws->index[u]) {
+                int w;
+                do {
+                    w = ws->stack[--stackTop];
+                    ws->onStack[w] = 0;
+                    sccId[w] = nextId + components;
+                } while (w != u);
+                components++;
+            }
+            top--;
+            if (top >= 0) {
+                int parent = ws->frames[top].vertex;
+                if (ws->low[u] < ws->low[parent]) {
+                    ws->low[parent] = ws->low[u];
+                }
+            }
+        }
+    }
+
+    return components;
+}
+
+#endif // SCC_H
@@ -0,0 +1,131 @@
+#ifndef SCC_LEAN_H
+#define SCC_LEAN_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bit_matrix.h"
+#include "csr_graph.h"
+
+// Strongly connected components in about two words per vertex, after
+// Pearce's space-efficient Tarjan variant. A single rindex array replaces
+// Tarjan's index, low-link and on-stack arrays, and is finally overwritten
+// with the component ids. One stack of V ints is shared from both ends: DFS
+// frames grow up from the bottom and waiting vertices grow down from the top.
+// A DFS path vertex is never also waiting, so the two halves cannot meet.
+
+// Function to find the vertex a DFS frame is exploring. A frame only holds
+// its edge cursor; frame k > 0 was entered through the edge just before the
+// cursor of frame k - 1, so the vertex is that edge's target.
+static inline int sccLeanFrameVertex(const CsrGraph* graph, const int* stack, int top, int root) {
+    return top == 0 ? root : graph->targets[stack[top - 1] - 1];
+}
+
+// Function to label the SCCs of the graph without recursion. sccId doubles as
+// Pearce's rindex array while the search runs. Vertices with alive[v] == 0
+// (alive may be NULL) are taken as finished singleton components and numbered
+// first; the rest are numbered in the order they complete, which is a reverse
+// topological order of their condensation.
+// Returns the number of components, or -1 if allocation fails.
+static inline int sccComputeLean(const CsrGraph* graph, const unsigned char* alive, int* sccId) {
+    int n = graph->numVertices;
+    int* rindex = sccId;
+    int* stack = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    uint64_t* root = bitsetCreate(n);
+    if (!stack || !root) {
+        free(stack);
+        free(root);
+        return -1;
+    }
+
+    // Indices count up from 1 and finished ids count down from n - 1. Indices
+    // are reused as components complete, so the two ranges never overlap and
+    // every finished vertex compares greater than any live one.
+    int index = 1, c = n - 1, waiting = n;
+    for (int v = 0; v < n; v++) {
+        rindex[v] = 0;
+    }
+    if (alive) {
+        for (int v = 0; v < n; v++) {
+            if (!alive[v]) {
+                rindex[v] = c--;
+            }
+        }
+    }
+
+    for (int s = 0; s < n; s++) {
+        // A trimmed vertex can hold id 0, which also means unvisited
+        if (rindex[s] != 0 || (alive && !alive[s])) {
+            continue;
+        }
+
+        int top = 0, v = s;
+        stack[0] = graph->offsets[s];
+        rindex[s] = index++;
+        bitsetSet(root, s);
+
+        while (top >= 0) {
+            if (stack[top] < graph->offsets[v + 1]) {
+                int w = graph->targets[stack[top]++];
+                if (rindex[w] == 0) {
+                    rindex[w] = index++;
+                    bitsetSet(root, w);
+                    stack[++top] = graph->offsets[w];
+                    v = w;
+                } else if (rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    bitsetClear(root, v);
+                }
+                continue;
+            }
+
+            // v is finished: close its component if it is a root, else let it wait
+            if (bitsetTest(root, v)) {
+                index--;
+                while (waiting < n && rindex[v] <= rindex[stack[waiting]]) {
+                    rindex[stack[waiting++]] = c;
+                    index--;
+                }
+                rindex[v] = c--;
+            } else {
+                stack[--waiting] = v;
+            }
+
+            top--;
+            if (top >= 0) {
+                int parent = sccLeanFrameVertex(graph, stack, top, s);
+                if (rindex[v] < rindex[parent]) {
+                    rindex[parent] = rindex[v];
+                    bitsetClear(root, parent);
+                }
+                v = parent;
+            }
+        }
+    }
+
+    // Turn the countdown ids into 0, 1, ... in completion order
+    for (int v = 0; v < n; v++) {
+        sccId[v] = n - 1 - rindex[v];
+    }
+
+    free(stack);
+    free(root);
+    return n - 1 - c;
+}
+
+// Function to check whether a component holds a cycle: some member has an
+// edge to a member of the same component, a self-loop included. One pass
+// over the members' edges comparing ids.
+static inline int sccHasInternalEdge(const CsrGraph* graph, const int* sccId, const int* members, int count) {
+    for (int i = 0; i < count; i++) {
+        int u = members[i];
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            if (sccId[graph->targets[e]] == sccId[u]) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+#endif // SCC_LEAN_H
@@ -0,0 +1,512 @@
+#ifndef SCC_PARALLEL_H
+#define SCC_PARALLEL_H
+
+// Multicore strongly connected components. Compile with -pthread.
+// The barriers are POSIX, not C11: with -std=c11 the program must define
+// _POSIX_C_SOURCE 200112L before its first include.
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "int_vector.h"
+#include "scc_lean.h"
+
+#define PSCC_DONE 1   // Mark bit: the vertex's component is known
+#define PSCC_FW   2   // Mark bit: reached by the forward search from the pivot
+#define PSCC_BW   4   // Mark bit: reached by the backward search as well
+
+// What each phase of one run accounted for
+typedef struct {
+    int trimmed;          // Singleton components peeled by the trim pass
+    int pivotSize;        // Size of the component found by forward-backward
+    int colorIterations;  // Rounds of coloring needed for the rest
+} ParallelSccStats;
+
+// Shared state of one parallel SCC run. All threads run every phase on
+// their own slice of the work and meet at barriers in between:
+//  1. Trim: sources and sinks are peeled Kahn-style with atomic degrees.
+//  2. Forward-backward: the vertices both reachable from and reaching one
+//     high-degree pivot form its component, usually the giant one.
+//  3. Coloring: every vertex takes the largest id that reaches it, and each
+//     vertex that keeps its own id collects its component backwards.
+// Frontiers and live-vertex lists are built from per-thread buffers copied
+// to prefix-sum offsets, as in the parallel Kahn.
+typedef struct {
+    const CsrGraph* graph;
+    const CsrGraph* reverse;
+    int numThreads;
+    int* sccId;
+    _Atomic int* inDegree;        // Trim: edges from vertices not yet peeled
+    _Atomic int* outDegree;
+    _Atomic int* color;           // Coloring: largest id reaching the vertex
+    _Atomic unsigned char* mark;  // PSCC_* bits
+    int* frontier;                // Current BFS level
+    int* live;                    // Vertices whose component is still unknown
+    int liveCount;
+    int* counts;                  // Buffer size of each thread at a publish
+    int* pivots;                  // Best pivot candidate of each thread, -1 if none
+    _Atomic int changed[3];       // Coloring: set when a round raises a color, by round % 3
+    _Atomic int pivotSize;
+    _Atomic int nextId;
+    _Atomic int failed;           // Set if a thread could not grow its buffer
+    pthread_barrier_t barrier;
+    pthread_mutex_t gateLock;     // Workers wait here until every thread is created
+    pthread_cond_t gateOpen;
+    int gate;                     // 0 while starting, 1 to run, -1 to give up
+    ParallelSccStats stats;
+} ParallelScc;
+
+typedef struct {
+    ParallelScc* shared;
+    int id;
+} ParallelSccWorker;
+
+// Function to copy each thread's buffer to dest at prefix-sum offsets.
+// Returns the total number of items, or -1 if any thread failed.
+static inline int psccPublish(ParallelScc* ps, int t, IntVector* buffer, int* dest) {
+    ps->counts[t] = buffer->size;
+    pthread_barrier_wait(&ps->barrier);
+    if (atomic_load_explicit(&ps->failed, memory_order_relaxed)) {
+        return -1;
+    }
+
+    int offset = 0, total = 0;
+    for (int k = 0; k < ps->numThreads; k++) {
+        if (k < t) {
+            offset += ps->counts[k];
+        }
+        total += ps->counts[k];
+    }
+    for (int i = 0; i < buffer->size; i++) {
+        dest[offset + i] = buffer->items[i];
+    }
+    buffer->size = 0;
+    pthread_barrier_wait(&ps->barrier);  // dest complete before anyone reads it
+    return total;
+}
+
+static inline void psccPush(ParallelScc* ps, IntVector* buffer, int v) {
+    if (intVectorPush(buffer, v) != 0) {
+        atomic_store(&ps->failed, 1);
+    }
+}
+
+// Function to claim a vertex by setting a mark bit; only one thread gets 1
+static inline int psccClaim(ParallelScc* ps, int v, unsigned char bit) {
+    return !(atomic_fetch_or_explicit(&ps->mark[v], bit, memory_order_relaxed) & bit);
+}
+
+static inline int psccMark(const ParallelScc* ps, int v) {
+    return atomic_load_explicit(&ps->mark[v], memory_order_relaxed);
+}
+
+// Function to rebuild the live list from the vertices not yet marked done.
+// The first pass scans all vertices; later ones only the previous list.
+static inline int psccCompact(ParallelScc* ps, int t, IntVector* buffer, int fromAll) {
+    int total = fromAll ? ps->graph->numVertices : ps->liveCount;
+    int lo = (int)((long long)total * t / ps->numThreads);
+    int hi = (int)((long long)total * (t + 1) / ps->numThreads);
+    for (int i = lo; i < hi; i++) {
+        int v = fromAll ? i : ps->live[i];
+        if (!(psccMark(ps, v) & PSCC_DONE)) {
+            psccPush(ps, buffer, v);
+        }
+    }
+    int count = psccPublish(ps, t, buffer, ps->live);
+    if (t == 0 && count >= 0) {
+        ps->liveCount = count;
+    }
+    pthread_barrier_wait(&ps->barrier);
+    return count;
+}
+
+// Function to run a level-synchronous BFS from the published frontier.
+// A neighbor w is followed if it is not done, carries every bit in require,
+// and matches the color of the vertex it was reached from when sameColor is
+// set. Each newly reached vertex gets bit and, with assign set, the sccId of
+// the vertex it was reached from. Returns 0, or -1 if a thread failed.
+static inline int psccSearch(ParallelScc* ps, int t, IntVector* buffer, const CsrGraph* graph, int total,
+                             unsigned char require, unsigned char bit, int sameColor, int assign) {
+    while (total > 0) {
+        int lo = (int)((long long)total * t / ps->numThreads);
+        int hi = (int)((long long)total * (t + 1) / ps->numThreads);
+        for (int i = lo; i < hi; i++) {
+            int v = ps->frontier[i];
+            int c = sameColor ? atomic_load_explicit(&ps->color[v], memory_order_relaxed) : 0;
+            for (int e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+                int w = graph->targets[e];
+                int m = psccMark(ps, w);
+                if ((m & PSCC_DONE) || (m & bit) || (m & require) != require) {
+                    continue;
+                }
+                if (sameColor && atomic_load_explicit(&ps->color[w], memory_order_relaxed) != c) {
+                    continue;
+                }
+                if (psccClaim(ps, w, bit)) {
+                    if (assign) {
+                        ps->sccId[w] = ps->sccId[v];
+                    }
+                    psccPush(ps, buffer, w);
+                }
+            }
+        }
+        total = psccPublish(ps, t, buffer, ps->frontier);
+        if (total < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Phase 1: peel vertices without live in- or out-edges, one level at a time
+static inline int psccTrim(ParallelScc* ps, int t, IntVector* buffer) {
+    const CsrGraph* graph = ps->graph;
+    const CsrGraph* reverse = ps->reverse;
+    int n = graph->numVertices;
+    int lo = (int)((long long)n * t / ps->numThreads);
+    int hi = (int)((long long)n * (t + 1) / ps->numThreads);
+
+    for (int v = lo; v < hi; v++) {
+        atomic_init(&ps->inDegree[v], reverse->offsets[v + 1] - reverse->offsets[v]);
+        atomic_init(&ps->outDegree[v], graph->offsets[v + 1] - graph->offsets[v]);
+        atomic_init(&ps->mark[v], 0);
+        ps->sccId[v] = -1;
+    }
+    pthread_barrier_wait(&ps->barrier);
+
+    for (int v = lo; v < hi; v++) {
+        if ((atomic_load_explicit(&ps->inDegree[v], memory_order_relaxed) == 0 ||
+             atomic_load_explicit(&ps->outDegree[v], memory_order_relaxed) == 0) &&
+            psccClaim(ps, v, PSCC_DONE)) {
+            psccPush(ps, buffer, v);
+        }
+    }
+    int total = psccPublish(ps, t, buffer, ps->frontier);
+    int trimmed = 0;
+
+    while (total > 0) {
+        trimmed += total;
+        int levelLo = (int)((long long)total * t / ps->numThreads);
+        int levelHi = (int)((long long)total * (t + 1) / ps->numThreads);
+        for (int i = levelLo; i < levelHi; i++) {
+            int v = ps->frontier[i];
+            ps->sccId[v] = atomic_fetch_add_explicit(&ps->nextId, 1, memory_order_relaxed);
+            // Exactly one thread sees a degree drop from 1 to 0
+            for (int e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+                int w = graph->targets[e];
+                if (atomic_fetch_sub_explicit(&ps->inDegree[w], 1, memory_order_relaxed) == 1 &&
+                    psccClaim(ps, w, PSCC_DONE)) {
+                    psccPush(ps, buffer, w);
+                }
+            }
+            for (int e = reverse->offsets[v]; e < reverse->offsets[v + 1]; e++) {
+                int w = reverse->targets[e];
+                if (atomic_fetch_sub_explicit(&ps->outDegree[w], 1, memory_order_relaxed) == 1 &&
+                    psccClaim(ps, w, PSCC_DONE)) {
+                    psccPush(ps, buffer, w);
+                }
+            }
+        }
+        total = psccPublish(ps, t, buffer, ps->frontier);
+    }
+    if (total < 0) {
+        return -1;
+    }
+
+    if (t == 0) {
+        ps->stats.trimmed = trimmed;
+    }
+    return psccCompact(ps, t, buffer, 1);
+}
+
+// Phase 2: the component of a pivot is its forward set met by its backward set
+static inline int psccForwardBackward(ParallelScc* ps, int t, IntVector* buffer) {
+    const CsrGraph* graph = ps->graph;
+    int lo = (int)((long long)ps->liveCount * t / ps->numThreads);
+    int hi = (int)((long long)ps->liveCount * (t + 1) / ps->numThreads);
+
+    // Pivot: the live vertex with the largest in * out degree, likely in the giant SCC
+    long long bestScore = -1;
+    ps->pivots[t] = -1;
+    for (int i = lo; i < hi; i++) {
+        int v = ps->live[i];
+        long long score = (long long)(graph->offsets[v + 1] - graph->offsets[v]) *
+                          (ps->reverse->offsets[v + 1] - ps->reverse->offsets[v]);
+        if (score > bestScore) {
+            bestScore = score;
+            ps->pivots[t] = v;
+        }
+    }
+    pthread_barrier_wait(&ps->barrier);
+
+    int pivot = -1;
+    long long pivotScore = -1;
+    for (int k = 0; k < ps->numThreads; k++) {
+        int v = ps->pivots[k];
+        if (v == -1) {
+            continue;
+        }
+        long long score = (long long)(graph->offsets[v + 1] - graph->offsets[v]) *
+                          (ps->reverse->offsets[v + 1] - ps->reverse->offsets[v]);
+        if (score > pivotScore) {
+            pivotScore = score;
+            pivot = v;
+        }
+    }
+
+    if (t == 0) {
+        atomic_fetch_or_explicit(&ps->mark[pivot], PSCC_FW | PSCC_BW, memory_order_relaxed);
+        ps->sccId[pivot] = atomic_fetch_add_explicit(&ps->nextId, 1, memory_order_relaxed);
+        psccPush(ps, buffer, pivot);
+    }
+    int total = psccPublish(ps, t, buffer, ps->frontier);
+    if (total < 0 || psccSearch(ps, t, buffer, graph, total, 0, PSCC_FW, 0, 0) != 0) {
+        return -1;
+    }
+
+    // Backward only within the forward set, so whatever it reaches is the component
+    if (t == 0) {
+        psccPush(ps, buffer, pivot);
+    }
+    total = psccPublish(ps, t, buffer, ps->frontier);
+    if (total < 0 || psccSearch(ps, t, buffer, ps->reverse, total, PSCC_FW, PSCC_BW, 0, 1) != 0) {
+        return -1;
+    }
+
+    // Retire the component and clear the forward marks of everything else
+    int size = 0;
+    for (int i = lo; i < hi; i++) {
+        int v = ps->live[i];
+        int m = psccMark(ps, v);
+        if (m & PSCC_BW) {
+            atomic_store_explicit(&ps->mark[v], PSCC_DONE, memory_order_relaxed);
+            size++;
+        } else if (m & PSCC_FW) {
+            atomic_store_explicit(&ps->mark[v], 0, memory_order_relaxed);
+        }
+    }
+    atomic_fetch_add_explicit(&ps->pivotSize, size, memory_order_relaxed);
+    return psccCompact(ps, t, buffer, 0);
+}
+
+// Phase 3: repeat coloring until every component is known
+static inline int psccColoring(ParallelScc* ps, int t, IntVector* buffer) {
+    const CsrGraph* graph = ps->graph;
+    int round = 0;
+
+    while (ps->liveCount > 0) {
+        int lo = (int)((long long)ps->liveCount * t / ps->numThreads);
+        int hi = (int)((long long)ps->liveCount * (t + 1) / ps->numThreads);
+        for (int i = lo; i < hi; i++) {
+            atomic_store_explicit(&ps->color[ps->live[i]], ps->live[i], memory_order_relaxed);
+        }
+        pthread_barrier_wait(&ps->barrier);
+
+        // Push the largest id forward until nothing changes. Colors only
+        // grow, so threads may race freely and still reach the same fixpoint.
+        for (;;) {
+            int flag = round % 3;
+            if (t == 0) {
+                // Last read two rounds ago and next written after this round's barrier
+                atomic_store_explicit(&ps->changed[(round + 1) % 3], 0, memory_order_relaxed);
+            }
+            for (int i = lo; i < hi; i++) {
+                int v = ps->live[i];
+                int c = atomic_load_explicit(&ps->color[v], memory_order_relaxed);
+                for (int e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+                    int w = graph->targets[e];
+                    if (psccMark(ps, w) & PSCC_DONE) {
+                        continue;
+                    }
+                    int old = atomic_load_explicit(&ps->color[w], memory_order_relaxed);
+                    while (old < c) {
+                        if (atomic_compare_exchange_weak_explicit(&ps->color[w], &old, c,
+                                                                  memory_order_relaxed, memory_order_relaxed)) {
+                            atomic_store_explicit(&ps->changed[flag], 1, memory_order_relaxed);
+                            break;
+                        }
+                    }
+                }
+            }
+            pthread_barrier_wait(&ps->barrier);
+            int changed = atomic_load_explicit(&ps->changed[flag], memory_order_relaxed);
+            round++;
+            if (!changed) {
+                break;
+            }
+        }
+
+        // A vertex that kept its own color roots a component: the vertices
+        // of that color it reaches backwards
+        for (int i = lo; i < hi; i++) {
+            int v = ps->live[i];
+            if (atomic_load_explicit(&ps->color[v], memory_order_relaxed) == v) {
+                atomic_fetch_or_explicit(&ps->mark[v], PSCC_DONE, memory_order_relaxed);
+                ps->sccId[v] = atomic_fetch_add_explicit(&ps->nextId, 1, memory_order_relaxed);
+                psccPush(ps, buffer, v);
+            }
+        }
+        int total = psccPublish(ps, t, buffer, ps->frontier);
+        if (total < 0 || psccSearch(ps, t, buffer, ps->reverse, total, 0, PSCC_DONE, 1, 1) != 0) {
+            return -1;
+        }
+        if (t == 0) {
+            ps->stats.colorIterations++;
+        }
+        if (psccCompact(ps, t, buffer, 0) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static inline void* psccWorker(void* arg) {
+    ParallelSccWorker* worker = (ParallelSccWorker*)arg;
+    ParallelScc* ps = worker->shared;
+
+    // numThreads is only final once the gate opens
+    pthread_mutex_lock(&ps->gateLock);
+    while (ps->gate == 0) {
+        pthread_cond_wait(&ps->gateOpen, &ps->gateLock);
+    }
+    int gate = ps->gate;
+    pthread_mutex_unlock(&ps->gateLock);
+    if (gate < 0) {
+        return NULL;
+    }
+
+    int t = worker->id;
+    IntVector buffer = {NULL, 0, 0};
+    if (psccTrim(ps, t, &buffer) >= 0 && ps->liveCount > 0 &&
+        psccForwardBackward(ps, t, &buffer) >= 0) {
+        psccColoring(ps, t, &buffer);
+    }
+    free(buffer.items);
+    return NULL;
+}
+
+// Function to renumber components 0, 1, ... in order of their lowest vertex,
+// so the labelling does not depend on thread timing.
+// Returns the number of components, or -1 if allocation fails.
+static inline int psccCanonicalize(int n, int* sccId) {
+    int* renamed = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    if (!renamed) {
+        return -1;
+    }
+    for (int v = 0; v < n; v++) {
+        renamed[v] = -1;
+    }
+    int components = 0;
+    for (int v = 0; v < n; v++) {
+        if (renamed[sccId[v]] == -1) {
+            renamed[sccId[v]] = components++;
+        }
+        sccId[v] = renamed[sccId[v]];
+    }
+    free(renamed);
+    return components;
+}
+
+// Function to label the SCCs of the graph using numThreads threads.
+// Components are numbered in order of their lowest vertex; stats may be NULL.
+// Returns the number of components, or -1 if allocation or thread creation fails.
+static inline int csrParallelScc(const CsrGraph* graph, int numThreads, int* sccId, ParallelSccStats* stats) {
+    int n = graph->numVertices;
+    ParallelSccStats none = {0, 0, 0};
+    if (stats) {
+        *stats = none;
+    }
+    if (numThreads <= 1) {
+        // Barriers buy nothing on one thread
+        return sccComputeLean(graph, NULL, sccId) < 0 ? -1 : psccCanonicalize(n, sccId);
+    }
+
+    CsrGraph reverse;
+    if (csrTranspose(graph, &reverse) != 0) {
+        return -1;
+    }
+
+    ParallelScc ps;
+    ps.graph = graph;
+    ps.reverse = &reverse;
+    ps.numThreads = numThreads;
+    ps.sccId = sccId;
+    ps.liveCount = 0;
+    ps.stats = none;
+    ps.inDegree = (_Atomic int*)malloc(((size_t)n + 1) * sizeof(_Atomic int));
+    ps.outDegree = (_Atomic int*)malloc(((size_t)n + 1) * sizeof(_Atomic int));
+    ps.color = (_Atomic int*)malloc(((size_t)n + 1) * sizeof(_Atomic int));
+    ps.mark = (_Atomic unsigned char*)malloc(((size_t)n + 1) * sizeof(_Atomic unsigned char));
+    ps.frontier = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    ps.live = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    ps.counts = (int*)malloc(numThreads * sizeof(int));
+    ps.pivots = (int*)malloc(numThreads * sizeof(int));
+    pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    ParallelSccWorker* workers = (ParallelSccWorker*)malloc(numThreads * sizeof(ParallelSccWorker));
+    int result = -1;
+    if (!ps.inDegree || !ps.outDegree || !ps.color || !ps.mark || !ps.frontier || !ps.live ||
+        !ps.counts || !ps.pivots || !threads || !workers) {
+        goto cleanup;
+    }
+
+    atomic_init(&ps.nextId, 0);
+    atomic_init(&ps.failed, 0);
+    atomic_init(&ps.pivotSize, 0);
+    for (int k = 0; k < 3; k++) {
+        atomic_init(&ps.changed[k], 0);
+    }
+    pthread_mutex_init(&ps.gateLock, NULL);
+    pthread_cond_init(&ps.gateOpen, NULL);
+    ps.gate = 0;
+
+    // Run with however many threads could be created; the barrier is sized
+    // to that count before any worker passes the gate
+    int started = 0;
+    for (; started < numThreads; started++) {
+        workers[started].shared = &ps;
+        workers[started].id = started;
+        if (pthread_create(&threads[started], NULL, psccWorker, &workers[started]) != 0) {
+            break;
+        }
+    }
+    ps.numThreads = started;
+    int barrierReady = started > 0 && pthread_barrier_init(&ps.barrier, NULL, started) == 0;
+    pthread_mutex_lock(&ps.gateLock);
+    ps.gate = barrierReady ? 1 : -1;
+    pthread_cond_broadcast(&ps.gateOpen);
+    pthread_mutex_unlock(&ps.gateLock);
+
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    if (barrierReady) {
+        pthread_barrier_destroy(&ps.barrier);
+        if (!atomic_load(&ps.failed)) {
+            result = psccCanonicalize(n, sccId);
+            if (stats) {
+                *stats = ps.stats;
+                stats->pivotSize = atomic_load(&ps.pivotSize);
+            }
+        }
+    }
+    pthread_mutex_destroy(&ps.gateLock);
+    pthread_cond_destroy(&ps.gateOpen);
+
+cleanup:
+    csrFree(&reverse);
+    free(ps.inDegree);
+    free(ps.outDegree);
+    free(ps.color);
+    free(ps.mark);
+    free(ps.frontier);
+    free(ps.live);
+    free(ps.counts);
+    free(ps.pivots);
+    free(threads);
+    free(workers);
+    return result;
+}
+
+#endif // SCC_PARALLEL_H
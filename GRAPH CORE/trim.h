@@ -0,0 +1,67 @@
+#ifndef TRIM_H
+#define TRIM_H
+
+#include <stdlib.h>
+
+#include "csr_graph.h"
+#include "kahn.h"
+
+// Trim pre-pass: a vertex with no incoming or no outgoing edge cannot lie on
+// a cycle. Removing one can strip its neighbors of their last in- or
+// out-edge, so sources and sinks are peeled repeatedly, Kahn-style, in both
+// directions. What remains is the cyclic core: every cycle of the graph lies
+// inside it, and the detection and resolution passes only need to visit it.
+//
+// Sets alive[v] to 1 for core vertices and 0 for pruned ones.
+// Returns the number of vertices pruned, or -1 if allocation fails.
+static inline int csrTrim(const CsrGraph* graph, unsigned char* alive) {
+    int n = graph->numVertices;
+    int* inDegree = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* outDegree = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* queue = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    CsrGraph reverse;
+    if (!inDegree || !outDegree || !queue || csrTranspose(graph, &reverse) != 0) {
+        free(inDegree);
+        free(outDegree);
+        free(queue);
+        return -1;
+    }
+    csrInDegrees(graph, inDegree);
+
+    // Seed with every source and sink; alive drops to 0 once a vertex is queued
+    int front = 0, rear = 0;
+    for (int v = 0; v < n; v++) {
+        outDegree[v] = graph->offsets[v + 1] - graph->offsets[v];
+        alive[v] = 1;
+        if (inDegree[v] == 0 || outDegree[v] == 0) {
+            alive[v] = 0;
+            queue[rear++] = v;
+        }
+    }
+
+    while (front < rear) {
+        int current = queue[front++];
+        for (int e = graph->offsets[current]; e < graph->offsets[current + 1]; e++) {
+            int next = graph->targets[e];
+            if (alive[next] && --inDegree[next] == 0) {
+                alive[next] = 0;
+                queue[rear++] = next;
+            }
+        }
+        for (int e = reverse.offsets[current]; e < reverse.offsets[current + 1]; e++) {
+            int previous = reverse.targets[e];
+            if (alive[previous] && --outDegree[previous] == 0) {
+                alive[previous] = 0;
+                queue[rear++] = previous;
+            }
+        }
+    }
+
+    free(inDegree);
+    free(outDegree);
+    free(queue);
+    csrFree(&reverse);
+    return rear;
+}
+
+#endif // TRIM_H
@@ -0,0 +1,143 @@
+#ifndef WAIT_FOR_H
+#define WAIT_FOR_H
+
+#include <stdlib.h>
+
+#include "csr_graph.h"
+
+// Wait-for projection of a resource allocation graph. A request edge P -> R
+// followed by the assignment edge R -> H only says that P waits for H, so a
+// single-instance resource (at most one assignment edge, and to a process)
+// folds into direct edges P -> H. A resource nobody holds cannot lie on a
+// cycle and drops out with its request edges. Resources with several holders,
+// or with edges to other resources, stay as vertices, so cycles of the
+// projection are exactly the cycles of the original graph, each a little
+// under half as long. The pass is linear in the size of the graph.
+typedef struct {
+    CsrGraph graph;  // Kept vertices; weights[e] is the resource folded into edge e, or -1
+    int* original;   // Original id of each kept vertex
+    int collapsed;   // Resources folded away
+} WaitForGraph;
+
+static inline void waitForFree(WaitForGraph* wfg) {
+    csrFree(&wfg->graph);
+    free(wfg->original);
+    wfg->original = NULL;
+}
+
+// Function to project rag, where vertices 0 .. numProcesses - 1 are the
+// processes and the rest are resources. Neighbor order is preserved.
+// Returns 0 on success, -1 if allocation fails.
+static inline int waitForProject(const CsrGraph* rag, int numProcesses, WaitForGraph* wfg) {
+    int n = rag->numVertices;
+    int* newId = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    int* srcList = (int*)malloc(((size_t)rag->numEdges + 1) * sizeof(int));
+    int* destList = (int*)malloc(((size_t)rag->numEdges + 1) * sizeof(int));
+    int* via = (int*)malloc(((size_t)rag->numEdges + 1) * sizeof(int));
+    wfg->graph = (CsrGraph){0};
+    wfg->original = (int*)malloc(((size_t)n + 1) * sizeof(int));
+    wfg->collapsed = 0;
+    int result = -1;
+    if (!newId || !srcList || !destList || !via || !wfg->original) {
+        goto cleanup;
+    }
+
+    // A resource folds away if it has no holder, or exactly one that is a process
+    int kept = 0;
+    for (int v = 0; v < n; v++) {
+        int degree = rag->offsets[v + 1] - rag->offsets[v];
+        int folds = v >= numProcesses &&
+                    (degree == 0 || (degree == 1 && rag->targets[rag->offsets[v]] < numProcesses));
+        if (folds) {
+            newId[v] = -1;
+            wfg->collapsed++;
+        } else {
+            newId[v] = kept;
+            wfg->original[kept++] = v;
+        }
+    }
+
+    // Rows are fed back to front because csrBuild fills each row from its end
+    int edgeCount = 0;
+    for (int u = 0; u < n; u++) {
+        if (newId[u] == -1) {
+            continue;
+        }
+        for (int e = rag->offsets[u + 1] - 1; e >= rag->offsets[u]; e--) {
+            int v = rag->targets[e], resource = -1;
+            if (newId[v] == -1) {
+                if (rag->offsets[v + 1] == rag->offsets[v]) {
+                    continue;  // Free resource, the request is granted at once
+                }
+                resource = v;
+                v = rag->targets[rag->offsets[v]];
+            }
+            srcList[edgeCount] = newId[u];
+            destList[edgeCount] = newId[v];
+            via[edgeCount] = resource;
+            edgeCount++;
+        }
+    }
+    result = csrBuild(&wfg->graph, kept, edgeCount, srcList, destList, via);
+
+cleanup:
+    free(newId);
+    free(srcList);
+    free(destList);
+    free(via);
+    if (result != 0) {
+        waitForFree(wfg);
+    }
+    return result;
+}
+
+// Function to map a cycle of the projection back to the original graph,
+// putting each folded resource back between its requester and its holder.
+// out needs room for 2 * length ids. Returns the length of the mapped cycle.
+static inline int waitForExpandCycle(const WaitForGraph* wfg, const int* cycle, int length, int* out) {
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+        int u = cycle[i], v = cycle[(i + 1) % length];
+        int e = csrFindEdge(&wfg->graph, u, v);
+        out[count++] = wfg->original[u];
+        if (e != -1 && wfg->graph.weights[e] != -1) {
+            out[count++] = wfg->graph.weights[e];
+        }
+    }
+    return count;
+}
+
+static inline int waitForCompareInts(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Function to map an SCC of the projection back to the original graph: its
+// vertices plus every resource folded into an edge inside it, in original id
+// order. listed holds one zeroed flag per original vertex and is left zeroed;
+// out needs room for every original vertex.
+// Returns the number of original vertices written.
+static inline int waitForExpandScc(const WaitForGraph* wfg, const int* sccId, const int* members, int count,
+                                   unsigned char* listed, int* out) {
+    const CsrGraph* graph = &wfg->graph;
+    int total = 0;
+    for (int i = 0; i < count; i++) {
+        int u = members[i];
+        out[total++] = wfg->original[u];
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            int resource = graph->weights[e];
+            if (resource != -1 && sccId[graph->targets[e]] == sccId[u] && !listed[resource]) {
+                listed[resource] = 1;
+                out[total++] = resource;
+            }
+        }
+    }
+    // Members and resources are interleaved, so clear over the whole list
+    for (int i = 0; i < total; i++) {
+        listed[out[i]] = 0;
+    }
+    qsort(out, total, sizeof(int), waitForCompareInts);
+    return total;
+}
+
+#endif // WAIT_FOR_H
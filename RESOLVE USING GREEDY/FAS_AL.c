@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/feedback_arc_set.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/kahn.h"
+
+int main() {
+    int numProcesses, numResources, edges;
+
+    // User input for the number of processes, resources, and edges
+    printf("Enter number of processes: ");
+    scanf("%d", &numProcesses);
+    printf("Enter number of resources: ");
+    scanf("%d", &numResources);
+    printf("Enter number of edges: ");
+    scanf("%d", &edges);
+
+    int totalVertices = numProcesses + numResources;
+
+    // Input labels, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels (%d names): ", numProcesses);
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+
+    printf("Enter resource labels (%d names): ", numResources);
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int* weightList = (int*)malloc((edges + 1) * sizeof(int));
+    if (!srcList || !destList || !weightList) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+
+    // Input edges; the weight is the cost of preempting that edge
+    printf("Enter %d edges (source destination weight):\n", edges);
+    int edgeCount = 0;
+    for (int i = 0; i < edges; i++) {
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+        int weight;
+        scanf("%63s %63s %d", src, dest, &weight);
+
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
+
+        if (srcIndex != -1 && destIndex != -1) {
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            weightList[edgeCount] = weight;
+            edgeCount++;
+        } else {
+            printf("Invalid edge: %s -> %s\n", src, dest);
+        }
+    }
+
+    CsrGraph graph;
+    unsigned char* removed = (unsigned char*)malloc(edgeCount + 1);
+    if (!removed || csrBuild(&graph, totalVertices, edgeCount, srcList, destList, weightList) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    free(srcList);
+    free(destList);
+    free(weightList);
+
+    // One pass over the whole graph instead of repeated detect/remove rounds
+    long long cost = csrFeedbackArcSet(&graph, removed);
+    if (cost < 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+
+    printf("\n");
+    int removedCount = 0;
+    for (int u = 0; u < totalVertices; u++) {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+            if (removed[e]) {
+                printf("Removing edge: %s -> %s (Weight: %d)\n", internName(&labels, u), internName(&labels, graph.targets[e]), graph.weights[e]);
+                removedCount++;
+            }
+        }
+    }
+    if (removedCount == 0) {
+        printf("No deadlock detected.\n");
+    }
+    printf("Total preemption cost: %lld (%d edge(s) removed)\n", cost, removedCount);
+    int acyclic = csrIsAcyclicWithout(&graph, removed, NULL);
+    if (acyclic < 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    printf("%s\n", acyclic ? "Graph is acyclic after removal." : "Graph still has a cycle!");
+
+    // Output updated graph
+    printf("\nUpdated graph after removing edges:\n");
+    for (int i = 0; i < totalVertices; i++) {
+        printf("%s -> ", internName(&labels, i));
+        for (int e = graph.offsets[i]; e < graph.offsets[i + 1]; e++) {
+            if (!removed[e]) {
+                printf("%s(%d) -> ", internName(&labels, graph.targets[e]), graph.weights[e]);
+            }
+        }
+        printf("NULL\n");
+    }
+
+    // Free dynamically allocated memory
+    internFree(&labels);
+    csrFree(&graph);
+    free(removed);
+
+    return 0;
+}
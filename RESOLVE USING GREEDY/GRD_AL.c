@@ -1,119 +1,150 @@
+#define _POSIX_C_SOURCE 200112L  // clock_gettime under -std=c11
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <time.h>
 
-#define INF 99999 // Define a large number as infinity
-
-typedef struct EdgeInfo {
-    char from;
-    char to;
-    int weight;
-    struct EdgeInfo* next;  // To point to the next edge in the adjacency list
-} EdgeInfo;
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/cycle_arena.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/scc.h"
+#include "../GRAPH CORE/trim.h"
 
-typedef struct {
-    EdgeInfo* head; // Head of the adjacency list for each vertex
-} Vertex;
-
-typedef struct {
-    EdgeInfo* edges;
-    int edgeCount;
-} Cycle;
+#define INF 99999 // Define a large number as infinity
 
-int findIndex(char* labels, int size, char vertex) {
-    for (int i = 0; i < size; i++) {
-        if (labels[i] == vertex) {
-            return i;
+// Function to find the first edge from -> to that has not been removed
+int findLiveEdge(const CsrGraph* graph, const unsigned char* removed, int from, int to) {
+    for (int e = graph->offsets[from]; e < graph->offsets[from + 1]; e++) {
+        if (graph->targets[e] == to && !removed[e]) {
+            return e;
         }
     }
     return -1;
 }
 
-void dfs(int v, bool* visited, bool* recStack, Vertex* adjList, char* labels, Cycle* cycles, int* cycleCount, char* currentCycle, int* currentIndex, int size) {
+// Cycles are recorded as runs of CSR edge indices in the arena. Removed edges
+// are skipped, and with sccId set the search stays inside the start's component.
+void dfs(int v, bool* visited, bool* recStack, const CsrGraph* graph, const unsigned char* removed, const int* sccId, const InternTable* labels, CycleArena* cycles, int* currentCycle, int* currentIndex, int size) {
     visited[v] = true;
     recStack[v] = true;
-    currentCycle[*currentIndex] = labels[v];
+    currentCycle[*currentIndex] = v;
     (*currentIndex)++;
 
     if (*currentIndex >= size) {
         printf("Cycle buffer overflow detected!\n");
+        recStack[v] = false;
+        (*currentIndex)--;
         return;
     }
 
-    EdgeInfo* edge = adjList[v].head;
-    while (edge != NULL) {
-        int i = findIndex(labels, size, edge->to);
-        if (i != -1) {
-            if (!visited[i]) {
-                dfs(i, visited, recStack, adjList, labels, cycles, cycleCount, currentCycle, currentIndex, size);
-            } else if (recStack[i]) {
-                // Cycle detected
-                Cycle* currentCycleInfo = &cycles[*cycleCount];
-                int cycleStartIndex = 0;
-                while (currentCycle[cycleStartIndex] != labels[i]) {
-                    cycleStartIndex++;
-                }
-
-                for (int j = cycleStartIndex; j < *currentIndex; j++) {
-                    char from = currentCycle[j];
-                    char to = (j == *currentIndex - 1) ? currentCycle[cycleStartIndex] : currentCycle[j + 1];
-                    int edgeWeight = INF;  // Initialize edge weight as INF
-
-                    // Find edge weight
-                    EdgeInfo* tempEdge = adjList[findIndex(labels, size, from)].head;
-                    while (tempEdge != NULL) {
-                        if (tempEdge->to == to) {
-                            edgeWeight = tempEdge->weight;
-                            break;
-                        }
-                        tempEdge = tempEdge->next;
-                    }
+    for (int e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+        int i = graph->targets[e];
+        if (removed[e] || (sccId && sccId[i] != sccId[v])) {
+            continue;
+        }
+        if (!visited[i]) {
+            dfs(i, visited, recStack, graph, removed, sccId, labels, cycles, currentCycle, currentIndex, size);
+        } else if (recStack[i]) {
+            // Cycle detected
+            int cycleStartIndex = 0;
+            while (currentCycle[cycleStartIndex] != i) {
+                cycleStartIndex++;
+            }
 
-                    if (edgeWeight != INF) {
-                        currentCycleInfo->edges[currentCycleInfo->edgeCount++] = (EdgeInfo){from, to, edgeWeight};
-                    }
-                }
+            for (int j = cycleStartIndex; j < *currentIndex; j++) {
+                int from = currentCycle[j];
+                int to = (j == *currentIndex - 1) ? currentCycle[cycleStartIndex] : currentCycle[j + 1];
 
-                printf("Detected cycle: ");
-                for (int j = cycleStartIndex; j < *currentIndex; j++) {
-                    printf("%c ", currentCycle[j]);
+                // Find the edge; INF-weight edges are never candidates for removal
+                int edgeIndex = findLiveEdge(graph, removed, from, to);
+                if (edgeIndex != -1 && graph->weights[edgeIndex] != INF && cycleArenaPush(cycles, edgeIndex) != 0) {
+                    printf("Memory allocation failed!\n");
+                    exit(1);
                 }
-                printf("%c\n", currentCycle[cycleStartIndex]);
+            }
+            if (cycleArenaClose(cycles) != 0) {
+                printf("Memory allocation failed!\n");
+                exit(1);
+            }
 
-                (*cycleCount)++;
+            printf("Detected cycle: ");
+            for (int j = cycleStartIndex; j < *currentIndex; j++) {
+                printf("%s ", internName(labels, currentCycle[j]));
             }
+            printf("%s\n", internName(labels, currentCycle[cycleStartIndex]));
         }
-        edge = edge->next;
     }
 
     recStack[v] = false;
     (*currentIndex)--;
 }
 
-void removeEdge(Vertex* adjList, char from, char to, char* labels, int size) {
-    int fromIndex = findIndex(labels, size, from);
-    int toIndex = findIndex(labels, size, to);
-    if (fromIndex != -1 && toIndex != -1) {
-        EdgeInfo* prev = NULL;
-        EdgeInfo* curr = adjList[fromIndex].head;
-        while (curr != NULL) {
-            if (curr->to == to) {
-                if (prev == NULL) {
-                    adjList[fromIndex].head = curr->next;
-                } else {
-                    prev->next = curr->next;
-                }
-                free(curr);
-                break;
+// CSR rows are immutable, so removal marks the edge in a per-edge flag array.
+// Returns 1 if the edge was live, 0 if an earlier cycle already removed it.
+int removeEdge(unsigned char* removed, int edge) {
+    if (removed[edge]) {
+        return 0;
+    }
+    removed[edge] = 1;
+    return 1;
+}
+
+// Function to remove the minimum weight edge from each recorded cycle.
+// With skipBroken set, a cycle that lost an edge earlier in the batch is
+// already broken and costs nothing. dirty[v] is set for each removed edge's source.
+int removeCycleEdges(const CsrGraph* graph, unsigned char* removed, const CycleArena* cycles, const InternTable* labels, bool skipBroken, unsigned char* dirty) {
+    int count = 0;
+    for (int i = 0; i < cycles->count; i++) {
+        int length;
+        const int* cycleEdges = cycleArenaGet(cycles, i, &length);
+        if (length == 0) {
+            continue;
+        }
+
+        bool broken = false;
+        int minEdge = cycleEdges[0];
+        for (int j = 0; j < length; j++) {
+            broken = broken || removed[cycleEdges[j]];
+            if (graph->weights[cycleEdges[j]] < graph->weights[minEdge]) {
+                minEdge = cycleEdges[j];
             }
-            prev = curr;
-            curr = curr->next;
         }
+        if (skipBroken && broken) {
+            continue;
+        }
+
+        // Two cycles of one batch can share their cheapest edge
+        if (!removeEdge(removed, minEdge)) {
+            continue;
+        }
+        int from = csrEdgeSource(graph, minEdge);
+        int to = graph->targets[minEdge];
+        printf("Removing edge: %s -> %s (Weight: %d)\n", internName(labels, from), internName(labels, to), graph->weights[minEdge]);
+        dirty[from] = 1;
+        count++;
     }
+    return count;
+}
+
+// Function to check whether a single-vertex component still has a live self-loop
+bool hasLiveSelfLoop(const CsrGraph* graph, const unsigned char* removed, int v) {
+    return findLiveEdge(graph, removed, v, v) != -1;
 }
 
-int main() {
+double elapsedMs(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+// Usage: GRD_AL [--converge]
+// --converge repeats detection and removal until no deadlock remains. Each
+// round only re-verifies the SCCs that lost an edge in the previous round.
+int main(int argc, char* argv[]) {
     int numProcesses, numResources, edges;
+    bool converge = (argc > 1 && strcmp(argv[1], "--converge") == 0);
 
     // User input for the number of processes, resources, and edges
     printf("Enter number of processes: ");
@@ -125,123 +156,286 @@ int main() {
 
     int totalVertices = numProcesses + numResources;
 
-    // Dynamically allocate memory for labels, adjacency list, visited, and recStack
-    char* labels = (char*)malloc(totalVertices * sizeof(char));
-    Vertex* adjList = (Vertex*)malloc(totalVertices * sizeof(Vertex));
-    bool* visited = (bool*)malloc(totalVertices * sizeof(bool));
-    bool* recStack = (bool*)malloc(totalVertices * sizeof(bool));
-    char* currentCycle = (char*)malloc(totalVertices * sizeof(char));
-
-    // Check if memory allocation was successful
-    if (!labels || !adjList || !visited || !recStack || !currentCycle) {
+    // Input labels, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
         printf("Memory allocation failed!\n");
         return -1;
     }
-
-    // Initialize adjacency list
-    for (int i = 0; i < totalVertices; i++) {
-        adjList[i].head = NULL;
-    }
-
-    // Input labels
-    printf("Enter process labels (%d characters): ", numProcesses);
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels (%d names): ", numProcesses);
     for (int i = 0; i < numProcesses; i++) {
-        scanf(" %c", &labels[i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
 
-    printf("Enter resource labels (%d characters): ", numResources);
+    printf("Enter resource labels (%d names): ", numResources);
     for (int i = 0; i < numResources; i++) {
-        scanf(" %c", &labels[numProcesses + i]);
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    // Dynamically allocate memory for the edge stream, visited, and recStack
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int* weightList = (int*)malloc((edges + 1) * sizeof(int));
+    bool* visited = (bool*)malloc(totalVertices * sizeof(bool));
+    bool* recStack = (bool*)malloc(totalVertices * sizeof(bool));
+    int* currentCycle = (int*)malloc((totalVertices + 1) * sizeof(int));  // A DFS path holds each vertex at most once
+
+    // Check if memory allocation was successful
+    if (!srcList || !destList || !weightList || !visited || !recStack || !currentCycle) {
+        printf("Memory allocation failed!\n");
+        return -1;
     }
 
     // Input edges
     printf("Enter %d edges (source destination weight):\n", edges);
+    int edgeCount = 0;
     for (int i = 0; i < edges; i++) {
-        char src, dest;
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
         int weight;
-        scanf(" %c %c %d", &src, &dest, &weight);
+        scanf("%63s %63s %d", src, dest, &weight);
 
-        int srcIndex = findIndex(labels, totalVertices, src);
-        int destIndex = findIndex(labels, totalVertices, dest);
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
 
         if (srcIndex != -1 && destIndex != -1) {
-            // Add edge to adjacency list
-            EdgeInfo* newEdge = (EdgeInfo*)malloc(sizeof(EdgeInfo));
-            newEdge->from = src;
-            newEdge->to = dest;
-            newEdge->weight = weight;
-            newEdge->next = adjList[srcIndex].head;
-            adjList[srcIndex].head = newEdge;
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            weightList[edgeCount] = weight;
+            edgeCount++;
         } else {
-            printf("Invalid edge: %c -> %c\n", src, dest);
+            printf("Invalid edge: %s -> %s\n", src, dest);
         }
     }
 
-    // Initialize visited and recStack arrays
+    // Compress the edge stream into CSR form
+    CsrGraph graph;
+    unsigned char* removed = (unsigned char*)calloc(edgeCount + 1, sizeof(unsigned char));
+    if (!removed || csrBuild(&graph, totalVertices, edgeCount, srcList, destList, weightList) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    free(srcList);
+    free(destList);
+    free(weightList);
+
+    // Peel sources and sinks so the cycle search only walks the cyclic core
+    unsigned char* alive = (unsigned char*)malloc(totalVertices + 1);
+    int pruned = alive ? csrTrim(&graph, alive) : -1;
+    if (pruned < 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    printf("\nTrimmed %d of %d vertices before cycle search.\n", pruned, totalVertices);
+
+    // Initialize visited and recStack arrays; pruned vertices are never entered
     for (int i = 0; i < totalVertices; i++) {
-        visited[i] = false;
+        visited[i] = !alive[i];
         recStack[i] = false;
     }
 
-    // Initialize cycles
-    Cycle* cycles = (Cycle*)malloc(totalVertices * sizeof(Cycle));
-    int cycleCount = 0;
-    for (int i = 0; i < totalVertices; i++) {
-        cycles[i].edges = (EdgeInfo*)malloc(edges * sizeof(EdgeInfo)); // Max edges per cycle
-        cycles[i].edgeCount = 0;
+    // Cycles grow in an arena sized by what the DFS actually finds
+    CycleArena cycles;
+    if (cycleArenaInit(&cycles) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+
+    // Component labels of the original graph; converge mode splits them as edges go
+    int* sccId = (int*)malloc((totalVertices + 1) * sizeof(int));
+    unsigned char* dirty = (unsigned char*)calloc(totalVertices + 1, sizeof(unsigned char));
+    SccWorkspace ws = {0};
+    if (!sccId || !dirty || sccWorkspaceInit(&ws, totalVertices) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
     }
+    int nextId = sccCompute(&graph, 0, sccId, &ws);
 
     int currentIndex = 0;
+    struct timespec iterationStart;
+    clock_gettime(CLOCK_MONOTONIC, &iterationStart);
 
     // Perform DFS to detect cycles
     for (int i = 0; i < totalVertices; i++) {
         if (!visited[i]) {
-            dfs(i, visited, recStack, adjList, labels, cycles, &cycleCount, currentCycle, &currentIndex, totalVertices);
+            dfs(i, visited, recStack, &graph, removed, NULL, &labels, &cycles, currentCycle, &currentIndex, totalVertices + 1);
         }
     }
 
     // Remove the minimum weight edge from each cycle
-    for (int i = 0; i < cycleCount; i++) {
-        if (cycles[i].edgeCount > 0) {
-            int minIndex = 0;
-            for (int j = 1; j < cycles[i].edgeCount; j++) {
-                if (cycles[i].edges[j].weight < cycles[i].edges[minIndex].weight) {
-                    minIndex = j;
+    int batchRemoved = removeCycleEdges(&graph, removed, &cycles, &labels, false, dirty);
+
+    if (converge) {
+        // members holds the vertices of every cyclic component as one
+        // contiguous run; scope lists the runs still to be re-verified
+        int* members = (int*)malloc((totalVertices + 1) * sizeof(int));
+        int* sorted = (int*)malloc((totalVertices + 1) * sizeof(int));
+        int* runStart = (int*)malloc((totalVertices + 1) * sizeof(int));
+        int* runCount = (int*)malloc((totalVertices + 1) * sizeof(int));
+        int* nextStart = (int*)malloc((totalVertices + 1) * sizeof(int));
+        int* nextCount = (int*)malloc((totalVertices + 1) * sizeof(int));
+        int* bucket = (int*)calloc(nextId + 2, sizeof(int));
+        if (!members || !sorted || !runStart || !runCount || !nextStart || !nextCount || !bucket) {
+            printf("Memory allocation failed!\n");
+            return -1;
+        }
+
+        // Group the original components with a counting sort, keeping cyclic ones
+        for (int v = 0; v < totalVertices; v++) {
+            bucket[sccId[v] + 1]++;
+        }
+        for (int c = 0; c < nextId; c++) {
+            bucket[c + 1] += bucket[c];
+        }
+        for (int v = 0; v < totalVertices; v++) {
+            sorted[bucket[sccId[v]]++] = v;
+        }
+        int scopeSize = 0, used = 0;
+        for (int i = 0; i < totalVertices;) {
+            int j = i;
+            while (j < totalVertices && sccId[sorted[j]] == sccId[sorted[i]]) {
+                j++;
+            }
+            if (j - i > 1 || hasLiveSelfLoop(&graph, removed, sorted[i])) {
+                runStart[scopeSize] = used;
+                runCount[scopeSize] = j - i;
+                scopeSize++;
+                for (int k = i; k < j; k++) {
+                    members[used++] = sorted[k];
                 }
             }
+            i = j;
+        }
+        free(bucket);
+
+        int iteration = 1, totalRemoved = 0, unresolved = 0;
+        while (true) {
+            // Re-verify only the components that lost an edge in this round
+            int nextSize = 0, rechecked = 0;
+            for (int r = 0; r < scopeSize; r++) {
+                int* run = members + runStart[r];
+                int count = runCount[r];
+                bool touched = false;
+                for (int k = 0; k < count; k++) {
+                    touched = touched || dirty[run[k]];
+                    dirty[run[k]] = 0;
+                }
+                if (!touched) {
+                    // Cyclic, yet no cycle found in it had a removable edge
+                    printf("No removable edge in the deadlock around %s\n", internName(&labels, run[0]));
+                    unresolved++;
+                    continue;
+                }
 
-            printf("Removing edge: %c -> %c (Weight: %d)\n", cycles[i].edges[minIndex].from, cycles[i].edges[minIndex].to, cycles[i].edges[minIndex].weight);
-            removeEdge(adjList, cycles[i].edges[minIndex].from, cycles[i].edges[minIndex].to, labels, totalVertices);
+                rechecked++;
+                int base = nextId;
+                int parts = sccComputeWithin(&graph, run, count, removed, sccId, base, &ws);
+                nextId += parts;
+
+                // Split the run into its new components, in place
+                int* counts = ws.low;  // Free scratch once sccComputeWithin returns
+                for (int c = 0; c <= parts; c++) {
+                    counts[c] = 0;
+                }
+                for (int k = 0; k < count; k++) {
+                    counts[sccId[run[k]] - base + 1]++;
+                }
+                for (int c = 0; c < parts; c++) {
+                    counts[c + 1] += counts[c];
+                }
+                for (int k = 0; k < count; k++) {
+                    sorted[counts[sccId[run[k]] - base]++] = run[k];
+                }
+                for (int k = 0; k < count;) {
+                    int j = k;
+                    while (j < count && sccId[sorted[j]] == sccId[sorted[k]]) {
+                        j++;
+                    }
+                    if (j - k > 1 || hasLiveSelfLoop(&graph, removed, sorted[k])) {
+                        nextStart[nextSize] = runStart[r] + k;
+                        nextCount[nextSize] = j - k;
+                        nextSize++;
+                    }
+                    k = j;
+                }
+                memcpy(run, sorted, count * sizeof(int));
+            }
+
+            totalRemoved += batchRemoved;
+            printf("Iteration %d: %d edge(s) removed, %d SCC(s) rechecked\n", iteration, batchRemoved, rechecked);
+            fprintf(stderr, "Iteration %d took %.3f ms\n", iteration, elapsedMs(&iterationStart));  // Varies from run to run
+            if (nextSize == 0) {
+                break;
+            }
+
+            // Next round: search only the components that are still cyclic
+            int* swap = runStart; runStart = nextStart; nextStart = swap;
+            swap = runCount; runCount = nextCount; nextCount = swap;
+            scopeSize = nextSize;
+            iteration++;
+            clock_gettime(CLOCK_MONOTONIC, &iterationStart);
+
+            cycleArenaReset(&cycles);
+            currentIndex = 0;
+            for (int r = 0; r < scopeSize; r++) {
+                for (int k = 0; k < runCount[r]; k++) {
+                    visited[members[runStart[r] + k]] = false;
+                    recStack[members[runStart[r] + k]] = false;
+                }
+            }
+            for (int r = 0; r < scopeSize; r++) {
+                for (int k = 0; k < runCount[r]; k++) {
+                    int v = members[runStart[r] + k];
+                    if (!visited[v]) {
+                        dfs(v, visited, recStack, &graph, removed, sccId, &labels, &cycles, currentCycle, &currentIndex, totalVertices + 1);
+                    }
+                }
+            }
+            batchRemoved = removeCycleEdges(&graph, removed, &cycles, &labels, true, dirty);
+        }
+
+        printf("\nConverged after %d iteration(s): %d edge(s) removed.\n", iteration, totalRemoved);
+        if (unresolved > 0) {
+            printf("%d deadlock(s) remain with no removable edge.\n", unresolved);
+        } else {
+            printf("The graph is now free of deadlocks.\n");
         }
+
+        free(members);
+        free(sorted);
+        free(runStart);
+        free(runCount);
+        free(nextStart);
+        free(nextCount);
     }
 
     // Output updated graph
     printf("\nUpdated graph after removing edges:\n");
     for (int i = 0; i < totalVertices; i++) {
-        printf("%c -> ", labels[i]);
-        EdgeInfo* edge = adjList[i].head;
-        while (edge != NULL) {
-            printf("%c(%d) -> ", edge->to, edge->weight);
-            edge = edge->next;
+        printf("%s -> ", internName(&labels, i));
+        for (int e = graph.offsets[i]; e < graph.offsets[i + 1]; e++) {
+            if (!removed[e]) {
+                printf("%s(%d) -> ", internName(&labels, graph.targets[e]), graph.weights[e]);
+            }
         }
         printf("NULL\n");
     }
 
     // Free dynamically allocated memory
-    free(labels);
+    internFree(&labels);
     free(visited);
     free(recStack);
     free(currentCycle);
-    for (int i = 0; i < totalVertices; i++) {
-        EdgeInfo* edge = adjList[i].head;
-        while (edge != NULL) {
-            EdgeInfo* temp = edge;
-            edge = edge->next;
-            free(temp);
-        }
-    }
-    free(adjList);
-    free(cycles);
+    csrFree(&graph);
+    free(removed);
+    cycleArenaFree(&cycles);
+    free(alive);
+    free(sccId);
+    free(dirty);
+    sccWorkspaceFree(&ws);
 
     return 0;
 }
\ No newline at end of file
@@ -2,75 +2,134 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
-#define INF 99999 // Define a large number as infinity
+#include "../GRAPH CORE/bit_matrix.h"
+#include "../GRAPH CORE/cycle_arena.h"
+#include "../GRAPH CORE/intern_table.h"
 
-typedef struct {
-    char from;
-    char to;
-    int weight;
-} EdgeInfo;
+#define INF 99999 // Define a large number as infinity
 
+// Weighted graph on bit-packed rows. Weights are stored once per loaded edge,
+// packed in row-major bit order, and found by popcount rank within the row.
 typedef struct {
-    EdgeInfo* edges;
-    int edgeCount;
-} Cycle;
+    BitMatrix adjacency;  // Live edges, cleared as edges are removed
+    BitMatrix edgeBits;   // Edges as loaded, fixes the rank of each weight
+    int* rowStart;        // Index of each row's first weight
+    int* weights;
+} WeightedMatrix;
+
+// Function to build the packed weights once every edge bit is final
+int finalizeWeights(WeightedMatrix* matrix, const int* srcList, const int* destList, const int* weightList, int edgeCount) {
+    int size = matrix->adjacency.size;
+    size_t words = (size_t)size * matrix->adjacency.wordsPerRow;
+
+    if (bmCreate(&matrix->edgeBits, size) != 0) {
+        return -1;
+    }
+    for (size_t w = 0; w < words; w++) {
+        matrix->edgeBits.bits[w] = matrix->adjacency.bits[w];
+    }
 
-void initAdjMatrix(int** matrix, int size) {
+    matrix->rowStart = (int*)malloc((size + 1) * sizeof(int));
+    if (!matrix->rowStart) {
+        return -1;
+    }
+    matrix->rowStart[0] = 0;
     for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            matrix[i][j] = (i == j) ? 0 : INF; // 0 for self-loop, INF for no edge
+        matrix->rowStart[i + 1] = matrix->rowStart[i] + bmRowCount(&matrix->edgeBits, i);
+    }
+
+    matrix->weights = (int*)malloc((matrix->rowStart[size] + 1) * sizeof(int));
+    if (!matrix->weights) {
+        return -1;
+    }
+    // Later duplicates overwrite earlier ones, as the int matrix did
+    for (int i = 0; i < edgeCount; i++) {
+        int u = srcList[i];
+        int v = destList[i];
+        if (bmTest(&matrix->edgeBits, u, v)) {
+            matrix->weights[matrix->rowStart[u] + bitsetRank(bmRow(&matrix->edgeBits, u), v)] = weightList[i];
         }
     }
+    return 0;
 }
 
-int findIndex(char* labels, int size, char vertex) {
-    for (int i = 0; i < size; i++) {
-        if (labels[i] == vertex) {
-            return i;
+// Function to get the packed index of loaded edge u -> v, which also indexes its weight
+int edgeIndex(const WeightedMatrix* matrix, int u, int v) {
+    return matrix->rowStart[u] + bitsetRank(bmRow(&matrix->edgeBits, u), v);
+}
+
+// Function to recover both ends of a packed edge index
+void edgeEndpoints(const WeightedMatrix* matrix, int index, int* u, int* v) {
+    int lo = 0, hi = matrix->edgeBits.size - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (matrix->rowStart[mid] <= index) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
         }
     }
-    return -1;
+    *u = lo;
+    *v = bitsetSelect(bmRow(&matrix->edgeBits, lo), matrix->edgeBits.wordsPerRow, index - matrix->rowStart[lo]);
+}
+
+int edgeWeight(const WeightedMatrix* matrix, int u, int v) {
+    if (!bmTest(&matrix->adjacency, u, v)) {
+        return INF;
+    }
+    return matrix->weights[edgeIndex(matrix, u, v)];
 }
 
-void dfs(int v, bool* visited, bool* recStack, int** matrix, char* labels, Cycle* cycles, int* cycleCount, char* currentCycle, int* currentIndex, int size) {
+void freeWeightedMatrix(WeightedMatrix* matrix) {
+    bmFree(&matrix->adjacency);
+    bmFree(&matrix->edgeBits);
+    free(matrix->rowStart);
+    free(matrix->weights);
+}
+
+// Cycles are recorded as runs of packed edge indices in the arena
+void dfs(int v, bool* visited, bool* recStack, const WeightedMatrix* matrix, const InternTable* labels, CycleArena* cycles, int* currentCycle, int* currentIndex, int size) {
     visited[v] = true;
     recStack[v] = true;
-    currentCycle[*currentIndex] = labels[v];
+    currentCycle[*currentIndex] = v;
     (*currentIndex)++;
 
     if (*currentIndex >= size) {
         printf("Cycle buffer overflow detected!\n");
+        recStack[v] = false;
+        (*currentIndex)--;
         return;
     }
 
-    for (int i = 0; i < size; i++) {
-        if (matrix[v][i] != INF && matrix[v][i] != 0) { // There's an edge
-            if (!visited[i]) {
-                dfs(i, visited, recStack, matrix, labels, cycles, cycleCount, currentCycle, currentIndex, size);
-            } else if (recStack[i]) {
-                // Cycle detected
-                Cycle* currentCycleInfo = &cycles[*cycleCount];
-                int cycleStartIndex = 0;
-                while (currentCycle[cycleStartIndex] != labels[i]) {
-                    cycleStartIndex++;
-                }
-
-                for (int j = cycleStartIndex; j < *currentIndex; j++) {
-                    char from = currentCycle[j];
-                    char to = (j == *currentIndex - 1) ? currentCycle[cycleStartIndex] : currentCycle[j + 1];
-                    int edgeWeight = matrix[findIndex(labels, size, from)][findIndex(labels, size, to)];
-
-                    currentCycleInfo->edges[currentCycleInfo->edgeCount++] = (EdgeInfo){from, to, edgeWeight};
-                }
+    for (int i = bmNextInRow(&matrix->adjacency, v, 0); i != -1; i = bmNextInRow(&matrix->adjacency, v, i + 1)) {
+        if (!visited[i]) {
+            dfs(i, visited, recStack, matrix, labels, cycles, currentCycle, currentIndex, size);
+        } else if (recStack[i]) {
+            // Cycle detected
+            int cycleStartIndex = 0;
+            while (currentCycle[cycleStartIndex] != i) {
+                cycleStartIndex++;
+            }
 
-                printf("Detected cycle: ");
-                for (int j = cycleStartIndex; j < *currentIndex; j++) {
-                    printf("%c ", currentCycle[j]);
+            for (int j = cycleStartIndex; j < *currentIndex; j++) {
+                int from = currentCycle[j];
+                int to = (j == *currentIndex - 1) ? currentCycle[cycleStartIndex] : currentCycle[j + 1];
+                // Only live edges have a packed index; anything else can never be removed
+                if (bmTest(&matrix->adjacency, from, to) && cycleArenaPush(cycles, edgeIndex(matrix, from, to)) != 0) {
+                    printf("Memory allocation failed!\n");
+                    exit(1);
                 }
-                printf("%c\n", currentCycle[cycleStartIndex]);
+            }
+            if (cycleArenaClose(cycles) != 0) {
+                printf("Memory allocation failed!\n");
+                exit(1);
+            }
 
-                (*cycleCount)++;
+            printf("Detected cycle: ");
+            for (int j = cycleStartIndex; j < *currentIndex; j++) {
+                printf("%s ", internName(labels, currentCycle[j]));
             }
+            printf("%s\n", internName(labels, currentCycle[cycleStartIndex]));
         }
     }
 
@@ -78,12 +137,14 @@ void dfs(int v, bool* visited, bool* recStack, int** matrix, char* labels, Cycle
     (*currentIndex)--;
 }
 
-void removeEdge(int** matrix, char from, char to, char* labels, int size) {
-    int fromIndex = findIndex(labels, size, from);
-    int toIndex = findIndex(labels, size, to);
-    if (fromIndex != -1 && toIndex != -1) {
-        matrix[fromIndex][toIndex] = INF; // Remove the edge by setting it to infinity
+// Function to remove an edge by clearing its bit.
+// Returns 1 if the edge was live, 0 if an earlier cycle already removed it.
+int removeEdge(WeightedMatrix* matrix, int from, int to) {
+    if (!bmTest(&matrix->adjacency, from, to)) {
+        return 0;
     }
+    bmClear(&matrix->adjacency, from, to);
+    return 1;
 }
 
 int main() {
@@ -99,66 +160,93 @@ int main() {
 
     int totalVertices = numProcesses + numResources;
 
-    // Dynamically allocate memory for labels, adjacency matrix, visited, and recStack
-    char* labels = (char*)malloc(totalVertices * sizeof(char));
-    int** adjMatrix = (int**)malloc(totalVertices * sizeof(int*));
-    bool* visited = (bool*)malloc(totalVertices * sizeof(bool));
-    bool* recStack = (bool*)malloc(totalVertices * sizeof(bool));
-    char* currentCycle = (char*)malloc(totalVertices * sizeof(char));
-
-    // Check if memory allocation was successful
-    if (!labels || !adjMatrix || !visited || !recStack || !currentCycle) {
+    // Input labels, interned to dense vertex ids
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
         printf("Memory allocation failed!\n");
         return -1;
     }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels (%d names): ", numProcesses);
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
 
-    // Initialize adjacency matrix
-    for (int i = 0; i < totalVertices; i++) {
-        adjMatrix[i] = (int*)malloc(totalVertices * sizeof(int));
+    printf("Enter resource labels (%d names): ", numResources);
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
     }
+    totalVertices = labels.count;  // Repeated labels share one vertex
 
-    initAdjMatrix(adjMatrix, totalVertices);
+    // Dynamically allocate memory for the edge stream, visited, and recStack
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    int* weightList = (int*)malloc((edges + 1) * sizeof(int));
+    bool* visited = (bool*)malloc(totalVertices * sizeof(bool));
+    bool* recStack = (bool*)malloc(totalVertices * sizeof(bool));
+    int* currentCycle = (int*)malloc((totalVertices + 1) * sizeof(int));  // A DFS path holds each vertex at most once
 
-    // Input labels
-    printf("Enter process labels (%d characters): ", numProcesses);
-    for (int i = 0; i < numProcesses; i++) {
-        scanf(" %c", &labels[i]);
+    // Check if memory allocation was successful
+    if (!srcList || !destList || !weightList || !visited || !recStack || !currentCycle) {
+        printf("Memory allocation failed!\n");
+        return -1;
     }
 
-    printf("Enter resource labels (%d characters): ", numResources);
-    for (int i = 0; i < numResources; i++) {
-        scanf(" %c", &labels[numProcesses + i]);
+    // Initialize adjacency matrix
+    WeightedMatrix adjMatrix = {0};
+    if (bmCreate(&adjMatrix.adjacency, totalVertices) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
     }
 
     // Input edges
     printf("Enter %d edges (source destination weight):\n", edges);
+    int edgeCount = 0;
     for (int i = 0; i < edges; i++) {
-        char src, dest;
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
         int weight;
-        scanf(" %c %c %d", &src, &dest, &weight);
+        scanf("%63s %63s %d", src, dest, &weight);
 
-        int srcIndex = findIndex(labels, totalVertices, src);
-        int destIndex = findIndex(labels, totalVertices, dest);
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
 
         if (srcIndex != -1 && destIndex != -1) {
-            adjMatrix[srcIndex][destIndex] = weight; // Add edge
+            // Weights 0 and INF meant "no edge" in the int matrix
+            if (weight != 0 && weight != INF) {
+                bmSet(&adjMatrix.adjacency, srcIndex, destIndex); // Add edge
+            } else {
+                bmClear(&adjMatrix.adjacency, srcIndex, destIndex);
+            }
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            weightList[edgeCount] = weight;
+            edgeCount++;
         } else {
-            printf("Invalid edge: %c -> %c\n", src, dest);
+            printf("Invalid edge: %s -> %s\n", src, dest);
         }
     }
 
+    if (finalizeWeights(&adjMatrix, srcList, destList, weightList, edgeCount) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    free(srcList);
+    free(destList);
+    free(weightList);
+
     // Initialize visited and recStack arrays
     for (int i = 0; i < totalVertices; i++) {
         visited[i] = false;
         recStack[i] = false;
     }
 
-    // Initialize cycles
-    Cycle* cycles = (Cycle*)malloc(totalVertices * sizeof(Cycle));
-    int cycleCount = 0;
-    for (int i = 0; i < totalVertices; i++) {
-        cycles[i].edges = (EdgeInfo*)malloc(edges * sizeof(EdgeInfo)); // Max edges per cycle
-        cycles[i].edgeCount = 0;
+    // Cycles grow in an arena sized by what the DFS actually finds
+    CycleArena cycles;
+    if (cycleArenaInit(&cycles) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
     }
 
     int currentIndex = 0;
@@ -166,50 +254,49 @@ int main() {
     // Perform DFS to detect cycles
     for (int i = 0; i < totalVertices; i++) {
         if (!visited[i]) {
-            dfs(i, visited, recStack, adjMatrix, labels, cycles, &cycleCount, currentCycle, &currentIndex, totalVertices);
+            dfs(i, visited, recStack, &adjMatrix, &labels, &cycles, currentCycle, &currentIndex, totalVertices + 1);
         }
     }
 
     // Remove the minimum weight edge from each cycle
-    for (int i = 0; i < cycleCount; i++) {
-        if (cycles[i].edgeCount > 0) {
-            int minIndex = 0;
-            for (int j = 1; j < cycles[i].edgeCount; j++) {
-                if (cycles[i].edges[j].weight < cycles[i].edges[minIndex].weight) {
-                    minIndex = j;
+    for (int i = 0; i < cycles.count; i++) {
+        int length;
+        const int* cycleEdges = cycleArenaGet(&cycles, i, &length);
+        if (length > 0) {
+            // Compare loaded weights, so an edge removed for an earlier cycle still counts
+            int minEdge = cycleEdges[0];
+            for (int j = 1; j < length; j++) {
+                if (adjMatrix.weights[cycleEdges[j]] < adjMatrix.weights[minEdge]) {
+                    minEdge = cycleEdges[j];
                 }
             }
 
-            printf("Removing edge: %c -> %c (Weight: %d)\n", cycles[i].edges[minIndex].from, cycles[i].edges[minIndex].to, cycles[i].edges[minIndex].weight);
-            removeEdge(adjMatrix, cycles[i].edges[minIndex].from, cycles[i].edges[minIndex].to, labels, totalVertices);
+            // Two cycles can share their cheapest edge
+            int from, to;
+            edgeEndpoints(&adjMatrix, minEdge, &from, &to);
+            if (removeEdge(&adjMatrix, from, to)) {
+                printf("Removing edge: %s -> %s (Weight: %d)\n", internName(&labels, from), internName(&labels, to), adjMatrix.weights[minEdge]);
+            }
         }
     }
 
     // Output updated graph
     printf("\nUpdated graph after removing edges:\n");
     for (int i = 0; i < totalVertices; i++) {
-        printf("%c -> ", labels[i]);
-        for (int j = 0; j < totalVertices; j++) {
-            if (adjMatrix[i][j] != INF && adjMatrix[i][j] != 0) {
-                printf("%c(%d) -> ", labels[j], adjMatrix[i][j]);
-            }
+        printf("%s -> ", internName(&labels, i));
+        for (int j = bmNextInRow(&adjMatrix.adjacency, i, 0); j != -1; j = bmNextInRow(&adjMatrix.adjacency, i, j + 1)) {
+            printf("%s(%d) -> ", internName(&labels, j), edgeWeight(&adjMatrix, i, j));
         }
         printf("NULL\n");
     }
 
     // Free dynamically allocated memory
-    free(labels);
+    internFree(&labels);
     free(visited);
     free(recStack);
     free(currentCycle);
-    for (int i = 0; i < totalVertices; i++) {
-        free(adjMatrix[i]);
-    }
-    free(adjMatrix);
-    for (int i = 0; i < totalVertices; i++) {
-        free(cycles[i].edges);
-    }
-    free(cycles);
+    freeWeightedMatrix(&adjMatrix);
+    cycleArenaFree(&cycles);
 
     return 0;
 }
@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/feedback_vertex_set.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/kahn.h"
+
+int main() {
+    int numProcesses, numResources, edges;
+
+    printf("Enter number of processes, resources, and edges:\n");
+    scanf("%d %d %d", &numProcesses, &numResources, &edges);
+
+    int totalVertices = numProcesses + numResources;
+
+    // Input labels, interned to dense vertex ids; only processes can be aborted
+    InternTable labels;
+    if (internInit(&labels, totalVertices) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    char name[MAX_NAME_LENGTH];
+    printf("Enter process labels:\n");
+    for (int i = 0; i < numProcesses; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    int processCount = labels.count;  // Processes take the first ids
+    printf("Enter resource labels:\n");
+    for (int i = 0; i < numResources; i++) {
+        scanf("%63s", name);
+        internAdd(&labels, name);
+    }
+    totalVertices = labels.count;  // Repeated labels share one vertex
+
+    int* srcList = (int*)malloc((edges + 1) * sizeof(int));
+    int* destList = (int*)malloc((edges + 1) * sizeof(int));
+    double* cost = (double*)malloc((totalVertices + 1) * sizeof(double));
+    int* held = (int*)calloc(totalVertices + 1, sizeof(int));
+    unsigned char* candidate = (unsigned char*)calloc(totalVertices + 1, 1);
+    unsigned char* victim = (unsigned char*)malloc(totalVertices + 1);
+    if (!srcList || !destList || !cost || !held || !candidate || !victim) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+
+    // Input edges: resource -> process is an assignment, process -> resource a request
+    printf("Enter edges as pairs of labels (src dest):\n");
+    int edgeCount = 0;
+    for (int i = 0; i < edges; i++) {
+        char src[MAX_NAME_LENGTH], dest[MAX_NAME_LENGTH];
+        scanf("%63s %63s", src, dest);
+
+        int srcIndex = internLookup(&labels, src);
+        int destIndex = internLookup(&labels, dest);
+
+        if (srcIndex != -1 && destIndex != -1) {
+            srcList[edgeCount] = srcIndex;
+            destList[edgeCount] = destIndex;
+            edgeCount++;
+            if (srcIndex >= processCount && destIndex < processCount) {
+                held[destIndex]++;
+            }
+        } else {
+            printf("Invalid edge: %s -> %s\n", src, dest);
+        }
+    }
+
+    // Abort cost of each process: priority + rollback work + resources it holds
+    for (int v = 0; v < processCount; v++) {
+        cost[v] = 1 + held[v];  // Default priority 1, no rollback work
+        candidate[v] = 1;
+    }
+    printf("Enter process costs (label priority rollbackWork), one per process:\n");
+    for (int i = 0; i < numProcesses; i++) {
+        double priority, rollback;
+        if (scanf("%63s %lf %lf", name, &priority, &rollback) != 3) {
+            break;
+        }
+        int v = internLookup(&labels, name);
+        if (v == -1 || v >= processCount) {
+            printf("Unknown process: %s\n", name);
+            continue;
+        }
+        cost[v] = priority + rollback + held[v];
+        if (cost[v] <= 0) {
+            cost[v] = 1;  // Aborting is never free
+        }
+    }
+
+    CsrGraph graph;
+    if (csrBuild(&graph, totalVertices, edgeCount, srcList, destList, NULL) != 0) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+    free(srcList);
+    free(destList);
+
+    int victims = csrFeedbackVertexSet(&graph, cost, candidate, victim);
+    if (victims == -1) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+
+    printf("\n");
+    if (victims == FVS_UNBREAKABLE) {
+        printf("A cycle runs through resources only; aborting processes cannot break it.\n");
+    } else if (victims == 0) {
+        printf("No deadlock detected.\n");
+    } else {
+        double totalCost = 0;
+        for (int v = 0; v < processCount; v++) {
+            if (victim[v]) {
+                printf("Abort process: %s (Cost: %.2f)\n", internName(&labels, v), cost[v]);
+                totalCost += cost[v];
+            }
+        }
+        printf("Total abort cost: %.2f (%d process(es) aborted)\n", totalCost, victims);
+        int acyclic = csrIsAcyclicWithout(&graph, NULL, victim);
+        if (acyclic < 0) {
+            printf("Memory allocation failed!\n");
+            return -1;
+        }
+        printf("%s\n", acyclic ? "Graph is acyclic after aborting." : "Graph still has a cycle!");
+    }
+
+    // Free allocated memory
+    internFree(&labels);
+    csrFree(&graph);
+    free(cost);
+    free(held);
+    free(candidate);
+    free(victim);
+
+    return 0;
+}
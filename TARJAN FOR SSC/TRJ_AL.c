@@ -2,206 +2,205 @@
 #include <stdlib.h>
 #include <string.h>
 
-typedef struct Node {
-    int dest;
-    struct Node* next;
-} Node;
-
-Node** adjList;  // Adjacency list
-int* disc;       // Discovery time of nodes
-int* low;        // Low-link values
-int* inStack;    // Stack membership check
-int* stack;      // Stack for Tarjan's algorithm
-int stackTop = -1; // Top of stack
-int time = 0;    // Global timer for DFS discovery times
-char** nodeNames;  // Dynamically allocated array of strings for node names
-int nodeIndex = 0; // Counter for node indexes
-int hasDeadlock = 0; // Flag to check if a real deadlock exists
-
-// Dynamically allocate memory for name strings
-char* allocateName(const char* name) {
-    char* newName = (char*)malloc(strlen(name) + 1);
-    if (newName == NULL) {
-        printf("Memory allocation failed for name: %s\n", name);
-        exit(1);
-    }
-    strcpy(newName, name);
-    return newName;
+#include "../GRAPH CORE/csr_graph.h"
+#include "../GRAPH CORE/intern_table.h"
+#include "../GRAPH CORE/rag_input.h"
+#include "../GRAPH CORE/scc_lean.h"
+#include "../GRAPH CORE/trim.h"
+#include "../GRAPH CORE/wait_for.h"
+
+// Everything one analysis needs. Nothing is global, so a process can run
+// one engine per graph, each on its own thread.
+typedef struct {
+    InternTable nodeNames;  // Node names interned to dense indexes
+    CsrGraph graph;         // Adjacency in CSR form
+    int* sccId;             // Component of each node
+    unsigned char* alive;   // 0 for nodes peeled by the trim pass
+    int* memberStart;       // Component c is members[memberStart[c] .. memberStart[c + 1])
+    int* members;
+    int components;
+    int pruned;
+    WaitForGraph* projection;  // Set when the analysis runs on the wait-for graph
+    unsigned char* listed;     // Projection only: scratch for mapping SCCs back
+    int* expanded;
+} TarjanEngine;
+
+// Function to start an empty engine
+void engineInit(TarjanEngine* engine) {
+    engine->sccId = engine->memberStart = engine->members = NULL;
+    engine->alive = NULL;
+    engine->components = engine->pruned = 0;
+    engine->projection = NULL;
+    engine->listed = NULL;
+    engine->expanded = NULL;
 }
 
-// Map a name to a unique index, dynamically adding names
-int nameToIndex(const char* name) {
-    for (int i = 0; i < nodeIndex; i++) {
-        if (strcmp(nodeNames[i], name) == 0)
-            return i;
+// Function to read the graph from stdin with the shared loader and to size
+// all per-node arrays for it. processCount receives the number of distinct
+// process names. Returns 0 on success, -1 if allocation fails.
+int engineLoad(TarjanEngine* engine, int* processCount) {
+    if (ragRead(&engine->nodeNames, &engine->graph, processCount) != 0) {
+        return -1;
+    }
+    int totalNodes = engine->graph.numVertices;
+    engine->sccId = (int*)malloc((totalNodes + 1) * sizeof(int));
+    engine->alive = (unsigned char*)malloc(totalNodes + 1);
+    engine->memberStart = (int*)malloc((totalNodes + 2) * sizeof(int));
+    engine->members = (int*)malloc((totalNodes + 1) * sizeof(int));
+    if (!engine->sccId || !engine->alive || !engine->memberStart || !engine->members) {
+        return -1;
     }
-    nodeNames[nodeIndex] = allocateName(name);
-    return nodeIndex++;
+    return 0;
 }
 
-// Push to stack
-void push(int node) {
-    stack[++stackTop] = node;
-    inStack[node] = 1;
+// Function to switch the analysis to the wait-for projection, where nodes
+// 0 .. numProcesses - 1 are the processes. The per-node arrays only shrink.
+// Returns 0 on success, -1 if allocation fails.
+int engineProject(TarjanEngine* engine, int numProcesses) {
+    int totalNodes = engine->graph.numVertices;
+    engine->projection = (WaitForGraph*)malloc(sizeof(WaitForGraph));
+    engine->listed = (unsigned char*)calloc(totalNodes + 1, sizeof(unsigned char));
+    engine->expanded = (int*)malloc((totalNodes + 1) * sizeof(int));
+    if (!engine->projection || !engine->listed || !engine->expanded ||
+        waitForProject(&engine->graph, numProcesses, engine->projection) != 0) {
+        free(engine->projection);
+        engine->projection = NULL;
+        return -1;
+    }
+    return 0;
 }
 
-// Pop from stack
-int pop() {
-    int node = stack[stackTop--];
-    inStack[node] = 0;
-    return node;
+// The graph the analysis runs on
+const CsrGraph* engineGraph(const TarjanEngine* engine) {
+    return engine->projection ? &engine->projection->graph : &engine->graph;
 }
 
-// Add edge to adjacency list
-void addEdge(int u, int v) {
-    Node* newNode = (Node*)malloc(sizeof(Node));
-    if (newNode == NULL) {
-        printf("Memory allocation failed for edge\n");
-        exit(1);
+// Function to trim, label the SCCs and group the nodes of each one.
+// Returns 0 on success, -1 if allocation fails.
+int engineRun(TarjanEngine* engine) {
+    const CsrGraph* graph = engineGraph(engine);
+    int totalNodes = graph->numVertices;
+
+    // Peel sources and sinks; each is a trivial SCC that can never deadlock
+    engine->pruned = csrTrim(graph, engine->alive);
+    if (engine->pruned < 0) {
+        return -1;
+    }
+
+    // Run the iterative SCC engine; pruned nodes come back as singletons
+    engine->components = sccComputeLean(graph, engine->alive, engine->sccId);
+    if (engine->components < 0) {
+        return -1;
     }
-    newNode->dest = v;
-    newNode->next = adjList[u];
-    adjList[u] = newNode;
+
+    // Group nodes by component with a counting sort
+    int* memberStart = engine->memberStart;
+    for (int c = 0; c < engine->components + 2; c++) {
+        memberStart[c] = 0;
+    }
+    for (int i = 0; i < totalNodes; i++) {
+        memberStart[engine->sccId[i] + 2]++;
+    }
+    for (int c = 0; c < engine->components; c++) {
+        memberStart[c + 2] += memberStart[c + 1];
+    }
+    for (int i = 0; i < totalNodes; i++) {
+        engine->members[memberStart[engine->sccId[i] + 1]++] = i;
+    }
+    return 0;
 }
 
-// Tarjan's DFS to find SCCs
-void tarjanDFS(int u, int* isDeadlock) {
-    disc[u] = low[u] = ++time;
-    push(u);
-
-    Node* temp = adjList[u];
-    while (temp != NULL) {
-        int v = temp->dest;
-        if (disc[v] == -1) {
-            tarjanDFS(v, isDeadlock);
-            low[u] = (low[u] < low[v]) ? low[u] : low[v];
-        } else if (inStack[v]) {
-            low[u] = (low[u] < disc[v]) ? low[u] : disc[v];
+// Function to print every SCC, trimmed nodes included, and flag the deadlocked ones.
+// On the projection each SCC is printed with its folded resources put back.
+// Returns 1 if any deadlock was found.
+int engineReport(const TarjanEngine* engine) {
+    const CsrGraph* graph = engineGraph(engine);
+    int isDeadlock = 0;
+    for (int c = 0; c < engine->components; c++) {
+        int first = engine->memberStart[c], sccSize = engine->memberStart[c + 1] - engine->memberStart[c];
+        const int* nodes = engine->members + first;
+
+        // A real deadlock needs an edge inside the SCC, a self-loop included
+        int deadlocked = sccHasInternalEdge(graph, engine->sccId, nodes, sccSize);
+        const int* labels = nodes;
+        int labelCount = sccSize;
+        if (engine->projection) {
+            labelCount = waitForExpandScc(engine->projection, engine->sccId, nodes, sccSize, engine->listed, engine->expanded);
+            labels = engine->expanded;
         }
-        temp = temp->next;
-    }
 
-if (low[u] == disc[u]) {
-    int w, sccSize = 0;
-    char* sccNodes[nodeIndex];  // Temporary storage for SCC nodes
-    int idx = 0;
-
-    printf("SCC: ");
-    do {
-        w = pop();
-        sccNodes[idx++] = nodeNames[w];
-        printf("%s ", nodeNames[w]);
-        sccSize++;
-    } while (w != u);
-    printf("\n");
-
-    // Check for deadlock: SCC must have more than one node
-    if (sccSize > 1) {
-        for (int i = 0; i < idx; i++) {
-            for (Node* temp = adjList[nameToIndex(sccNodes[i])]; temp != NULL; temp = temp->next) {
-                for (int j = 0; j < idx; j++) {
-                    if (strcmp(nodeNames[temp->dest], sccNodes[j]) == 0) {
-                        *isDeadlock = 1;  // Update the global flag
-                        break;
-                    }
-                }
-                if (*isDeadlock) break;
-            }
-            if (*isDeadlock) break;
+        printf("SCC: ");
+        for (int i = 0; i < labelCount; i++) {
+            printf("%s ", internName(&engine->nodeNames, labels[i]));
         }
-        if (*isDeadlock) {
+        printf("\n");
+
+        if (deadlocked) {
+            isDeadlock = 1;
             printf("Deadlock SCC Detected: ");
-            for (int i = 0; i < idx; i++) {
-                printf("%s ", sccNodes[i]);
+            for (int i = 0; i < labelCount; i++) {
+                printf("%s ", internName(&engine->nodeNames, labels[i]));
             }
             printf("\n");
         }
     }
+    return isDeadlock;
 }
 
-
+void engineFree(TarjanEngine* engine) {
+    internFree(&engine->nodeNames);
+    csrFree(&engine->graph);
+    free(engine->sccId);
+    free(engine->alive);
+    free(engine->memberStart);
+    free(engine->members);
+    if (engine->projection) {
+        waitForFree(engine->projection);
+        free(engine->projection);
+    }
+    free(engine->listed);
+    free(engine->expanded);
 }
 
-int main() {
-    int numProcesses, numResources, numEdges;
-    char process[10], resource[10], source[10], destination[10];
-
-    printf("Enter number of processes, resources, and edges: ");
-    scanf("%d %d %d", &numProcesses, &numResources, &numEdges);
+// Usage: TRJ_AL [--wait-for]
+// --wait-for labels the SCCs of the wait-for projection, with single-instance
+// resources folded into process -> process edges.
+int main(int argc, char* argv[]) {
+    int waitFor = (argc > 1 && strcmp(argv[1], "--wait-for") == 0);
 
-    int totalNodes = numProcesses + numResources;
+    TarjanEngine engine;
+    engineInit(&engine);
 
-    // Dynamically allocate memory for arrays
-    adjList = (Node**)malloc(totalNodes * sizeof(Node*));
-    disc = (int*)malloc(totalNodes * sizeof(int));
-    low = (int*)malloc(totalNodes * sizeof(int));
-    inStack = (int*)malloc(totalNodes * sizeof(int));
-    stack = (int*)malloc(totalNodes * sizeof(int));
-    nodeNames = (char**)malloc(totalNodes * sizeof(char*));
-
-    if (!adjList || !disc || !low || !inStack || !stack || !nodeNames) {
+    // Read the graph and size the engine for it
+    int processCount;
+    if (engineLoad(&engine, &processCount) != 0) {
         printf("Memory allocation failed\n");
         exit(1);
     }
+    int totalNodes = engine.graph.numVertices;
 
-    // Initialize adjacency list and other arrays
-    for (int i = 0; i < totalNodes; i++) {
-        adjList[i] = NULL;
-        disc[i] = -1;
-        low[i] = -1;
-        inStack[i] = 0;
-    }
-
-    // Processes and resources input
-    printf("Enter process names: ");
-    for (int i = 0; i < numProcesses; i++) {
-        scanf("%s", process);
-        nameToIndex(process);
-    }
-
-    printf("Enter resource names: ");
-    for (int i = 0; i < numResources; i++) {
-        scanf("%s", resource);
-        nameToIndex(resource);
-    }
-
-    // Edges input
-    printf("Enter edges (source destination):\n");
-    for (int i = 0; i < numEdges; i++) {
-        scanf("%s %s", source, destination);
-        int u = nameToIndex(source);
-        int v = nameToIndex(destination);
-        addEdge(u, v);
+    if (waitFor) {
+        if (engineProject(&engine, processCount) != 0) {
+            printf("Memory allocation failed\n");
+            exit(1);
+        }
+        printf("\nWait-for graph: %d of %d nodes kept, %d resource(s) folded into edges.\n",
+               engine.projection->graph.numVertices, totalNodes, engine.projection->collapsed);
+        totalNodes = engine.projection->graph.numVertices;
     }
 
-    int isDeadlock = 0;
-    // Run Tarjan's algorithm to find SCCs
-    for (int i = 0; i < nodeIndex; i++) {
-        if (disc[i] == -1) {
-            tarjanDFS(i, &isDeadlock);
-        }
+    if (engineRun(&engine) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
     }
+    printf("\nTrimmed %d of %d nodes (trivial SCCs) before Tarjan.\n", engine.pruned, totalNodes);
 
-    if (isDeadlock==0) {
+    if (engineReport(&engine) == 0) {
         printf("No deadlock detected in the graph\n");
     }
 
     // Free dynamically allocated memory
-    for (int i = 0; i < nodeIndex; i++) {
-        Node* temp = adjList[i];
-        while (temp) {
-            Node* toFree = temp;
-            temp = temp->next;
-            free(toFree);
-        }
-        free(nodeNames[i]);
-    }
-    free(adjList);
-    free(disc);
-    free(low);
-    free(inStack);
-    free(stack);
-    free(nodeNames);
+    engineFree(&engine);
 
     return 0;
 }
@@ -1,183 +1,218 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 
-// Global variables
-int **adjMatrix;            // Adjacency matrix
-int *disc;                  // Discovery time of nodes
-int *low;                   // Low-link values
-int *inStack;               // Stack membership check
-int *stack;                 // Stack for Tarjan's algorithm
-int time = 0;               // Timer for discovery times
-int stackTop = -1;          // Stack pointer
-int nodeCount = 0;          // Total unique nodes in the graph
+#include "../GRAPH CORE/bit_matrix.h"
+#include "../GRAPH CORE/intern_table.h"
+
+// State of one analysis. Nothing is global, so a process can run one
+// engine per graph, each on its own thread.
+typedef struct {
+    BitMatrix adjMatrix;        // Bit-packed adjacency matrix
+    int *disc;                  // Discovery time of nodes
+    int *low;                   // Low-link values
+    uint64_t *inStack;          // Stack membership bitset
+    int *stack;                 // Stack for Tarjan's algorithm
+    int *sccId;                 // Component of each node, -1 until it is popped
+    int sccCount;               // Components found so far
+    int time;                   // Timer for discovery times
+    int stackTop;               // Stack pointer
+    int nodeCount;              // Total unique nodes in the graph
+    InternTable nodeNames;      // Node names interned to dense indexes
+    int hasDeadlock;            // Flag to check if a real deadlock exists
+} TarjanEngine;
+
+// Function to start an engine with room for the expected number of names.
+// Returns 0 on success, -1 if allocation fails.
+int engineInit(TarjanEngine* engine, int expectedNodes) {
+    engine->adjMatrix = (BitMatrix){0};
+    engine->disc = engine->low = engine->stack = engine->sccId = NULL;
+    engine->inStack = NULL;
+    engine->sccCount = engine->time = engine->nodeCount = engine->hasDeadlock = 0;
+    engine->stackTop = -1;
+    return internInit(&engine->nodeNames, expectedNodes);
+}
 
-// Map names to indices
-int nodeIndex = 0;
-char **nodeNames;          // Store node names dynamically
+// Function to map names to unique indices
+int nameToIndex(TarjanEngine* engine, const char* name) {
+    int index = internAdd(&engine->nodeNames, name);
+    if (index == -1) {
+        printf("Memory allocation failed for name: %s\n", name);
+        exit(1);
+    }
+    return index;
+}
 
-// Flag to check if a real deadlock exists
-int hasDeadlock = 0;
+// Function to build the matrix once every name is known, and to size all
+// per-node arrays for it. Returns 0 on success, -1 if allocation fails.
+int engineBuild(TarjanEngine* engine, int numEdges, const int* srcList, const int* destList) {
+    int nodeCount = engine->nodeNames.count;
+    engine->nodeCount = nodeCount;
+    if (bmCreate(&engine->adjMatrix, nodeCount) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < numEdges; i++) {
+        bmSet(&engine->adjMatrix, srcList[i], destList[i]);  // Set edge from source to destination
+    }
 
-// Function to map names to unique indices
-int nameToIndex(const char* name) {
-    for (int i = 0; i < nodeIndex; i++) {
-        if (strcmp(nodeNames[i], name) == 0)
-            return i;
+    engine->disc = (int*)malloc(nodeCount * sizeof(int));
+    engine->low = (int*)malloc(nodeCount * sizeof(int));
+    engine->inStack = bitsetCreate(nodeCount);
+    engine->stack = (int*)malloc(nodeCount * sizeof(int));
+    engine->sccId = (int*)malloc(nodeCount * sizeof(int));
+    if (!engine->disc || !engine->low || !engine->inStack || !engine->stack || !engine->sccId) {
+        return -1;
     }
-    nodeNames[nodeIndex] = (char*)malloc(strlen(name) + 1); // Dynamically allocate memory for node name
-    strcpy(nodeNames[nodeIndex], name);
-    return nodeIndex++;
+
+    // Initialize arrays
+    for (int i = 0; i < nodeCount; i++) {
+        engine->disc[i] = -1;
+        engine->low[i] = -1;
+        engine->sccId[i] = -1;
+    }
+    return 0;
+}
+
+void engineFree(TarjanEngine* engine) {
+    bmFree(&engine->adjMatrix);
+    free(engine->disc);
+    free(engine->low);
+    free(engine->inStack);
+    free(engine->stack);
+    free(engine->sccId);
+    internFree(&engine->nodeNames);
 }
 
 // Push to stack
-void push(int node) {
-    stack[++stackTop] = node;
-    inStack[node] = 1;
+void push(TarjanEngine* engine, int node) {
+    engine->stack[++engine->stackTop] = node;
+    bitsetSet(engine->inStack, node);
 }
 
 // Pop from stack
-int pop() {
-    int node = stack[stackTop--];
-    inStack[node] = 0;
+int pop(TarjanEngine* engine) {
+    int node = engine->stack[engine->stackTop--];
+    bitsetClear(engine->inStack, node);
     return node;
 }
 
 // Tarjan's DFS to find SCCs
-void tarjanDFS(int u) {
-    disc[u] = low[u] = ++time;
-    push(u);
-
-    for (int v = 0; v < nodeCount; v++) {
-        if (adjMatrix[u][v]) { // Check if there is an edge u -> v
-            if (disc[v] == -1) {
-                tarjanDFS(v);
-                low[u] = (low[u] < low[v]) ? low[u] : low[v];
-            } else if (inStack[v]) {
-                low[u] = (low[u] < disc[v]) ? low[u] : disc[v];
-            }
+void tarjanDFS(TarjanEngine* engine, int u) {
+    BitMatrix* adjMatrix = &engine->adjMatrix;
+    int* disc = engine->disc;
+    int* low = engine->low;
+
+    disc[u] = low[u] = ++engine->time;
+    push(engine, u);
+
+    // Visit each edge u -> v, skipping empty columns a word at a time
+    for (int v = bmNextInRow(adjMatrix, u, 0); v != -1; v = bmNextInRow(adjMatrix, u, v + 1)) {
+        if (disc[v] == -1) {
+            tarjanDFS(engine, v);
+            low[u] = (low[u] < low[v]) ? low[u] : low[v];
+        } else if (bitsetTest(engine->inStack, v)) {
+            low[u] = (low[u] < disc[v]) ? low[u] : disc[v];
         }
     }
 
     if (low[u] == disc[u]) {
-        // Collect SCC nodes
-        int w, sccSize = 0;
+        // Collect SCC nodes; they are the stack entries above u's slot
+        int w;
+        int first = engine->stackTop;
         printf("SCC: ");
-        char *sccNodes[nodeCount];
-        int idx = 0;
-
         do {
-            w = pop();
-            sccNodes[idx++] = nodeNames[w];
-            printf("%s ", nodeNames[w]);
-            sccSize++;
+            w = pop(engine);
+            engine->sccId[w] = engine->sccCount;
+            printf("%s ", internName(&engine->nodeNames, w));
         } while (w != u);
         printf("\n");
-
-        // Check if this SCC qualifies as a real deadlock
-        if (sccSize > 1) {  // Ensure SCC has more than one node
-            int isDeadlock = 0;
-            for (int i = 0; i < idx; i++) {
-                for (int j = 0; j < idx; j++) {
-                    if (i != j) {
-                        int uIndex = nameToIndex(sccNodes[i]);
-                        int vIndex = nameToIndex(sccNodes[j]);
-                        if (adjMatrix[uIndex][vIndex]) {
-                            isDeadlock = 1;
-                            break;
-                        }
-                    }
+        int* sccNodes = engine->stack + engine->stackTop + 1;
+        int idx = first - engine->stackTop;
+
+        // A real deadlock needs an edge inside the SCC, a self-loop included.
+        // One pass over the members' rows comparing component ids.
+        int isDeadlock = 0;
+        for (int i = 0; i < idx && !isDeadlock; i++) {
+            for (int v = bmNextInRow(adjMatrix, sccNodes[i], 0); v != -1; v = bmNextInRow(adjMatrix, sccNodes[i], v + 1)) {
+                if (engine->sccId[v] == engine->sccCount) {
+                    isDeadlock = 1;
+                    break;
                 }
-                if (isDeadlock) break;
             }
-            if (isDeadlock) {
-                printf("Deadlock SSC Detected: ");
-                for (int i = 0; i < idx; i++) {
-                    printf("%s ", sccNodes[i]);
-                }
-                printf("\n");
-                hasDeadlock = 1;
+        }
+        if (isDeadlock) {
+            printf("Deadlock SSC Detected: ");
+            for (int i = idx - 1; i >= 0; i--) {
+                printf("%s ", internName(&engine->nodeNames, sccNodes[i]));
             }
+            printf("\n");
+            engine->hasDeadlock = 1;
         }
+        engine->sccCount++;
     }
 }
 
 int main() {
     int numProcesses, numResources, numEdges;
-    char process[10], resource[10], source[10], destination[10];
+    char process[MAX_NAME_LENGTH], resource[MAX_NAME_LENGTH], source[MAX_NAME_LENGTH], destination[MAX_NAME_LENGTH];
 
     // Input format
     printf("Enter the number of processes, resources, and edges: ");
     scanf("%d %d %d", &numProcesses, &numResources, &numEdges);
 
-    // Dynamically allocate memory based on the actual number of nodes
-    nodeCount = numProcesses + numResources; // Total number of nodes (processes + resources)
-
-    // Dynamically allocate memory for adjacency matrix and other arrays
-    adjMatrix = (int**)malloc(nodeCount * sizeof(int*));
-    for (int i = 0; i < nodeCount; i++) {
-        adjMatrix[i] = (int*)calloc(nodeCount, sizeof(int));  // Initialize to 0
-    }
-
-    disc = (int*)malloc(nodeCount * sizeof(int));
-    low = (int*)malloc(nodeCount * sizeof(int));
-    inStack = (int*)malloc(nodeCount * sizeof(int));
-    stack = (int*)malloc(nodeCount * sizeof(int));
-    nodeNames = (char**)malloc(nodeCount * sizeof(char*));
-
-    // Initialize arrays
-    for (int i = 0; i < nodeCount; i++) {
-        disc[i] = -1;
-        low[i] = -1;
-        inStack[i] = 0;
+    TarjanEngine engine;
+    if (engineInit(&engine, numProcesses + numResources) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
     }
 
     // Process and resource inputs
     printf("Enter processes: ");
     for (int i = 0; i < numProcesses; i++) {
-        scanf("%s", process);
-        nameToIndex(process);
+        scanf("%63s", process);
+        nameToIndex(&engine, process);
     }
 
     printf("Enter resources: ");
     for (int i = 0; i < numResources; i++) {
-        scanf("%s", resource);
-        nameToIndex(resource);
+        scanf("%63s", resource);
+        nameToIndex(&engine, resource);
     }
 
     printf("Enter edges (source destination):\n");
+    int* srcList = (int*)malloc((numEdges + 1) * sizeof(int));
+    int* destList = (int*)malloc((numEdges + 1) * sizeof(int));
+    if (!srcList || !destList) {
+        printf("Memory allocation failed\n");
+        exit(1);
+    }
     for (int i = 0; i < numEdges; i++) {
-        scanf("%s %s", source, destination);
-        int u = nameToIndex(source);
-        int v = nameToIndex(destination);
-        adjMatrix[u][v] = 1;  // Set edge from source to destination
+        scanf("%63s %63s", source, destination);
+        srcList[i] = nameToIndex(&engine, source);
+        destList[i] = nameToIndex(&engine, destination);
+    }
+
+    // Names first seen on an edge become nodes too, so the engine sizes by the final count
+    if (engineBuild(&engine, numEdges, srcList, destList) != 0) {
+        printf("Memory allocation failed\n");
+        exit(1);
     }
+    free(srcList);
+    free(destList);
 
     // Run Tarjan's algorithm to find SCCs (Deadlocks)
-    for (int i = 0; i < nodeCount; i++) {
-        if (disc[i] == -1) {
-            tarjanDFS(i);
+    for (int i = 0; i < engine.nodeCount; i++) {
+        if (engine.disc[i] == -1) {
+            tarjanDFS(&engine, i);
         }
     }
 
     // If no real deadlocks were detected
-    if (!hasDeadlock) {
+    if (!engine.hasDeadlock) {
         printf("No real deadlock detected.\n");
     }
 
     // Free dynamically allocated memory
-    for (int i = 0; i < nodeCount; i++) {
-        free(adjMatrix[i]);
-    }
-    free(adjMatrix);
-    free(disc);
-    free(low);
-    free(inStack);
-    free(stack);
-    for (int i = 0; i < nodeIndex; i++) {
-        free(nodeNames[i]);
-    }
-    free(nodeNames);
+    engineFree(&engine);
 
     return 0;
 }